@@ -43,5 +43,21 @@ int main(int argc, char* argv[])
     std::cout << "number of terms: "
         << rcp_dynamic_cast<const Add>(a)->dict_.size() << std::endl;
 
+    SymEngine::AddBuilder b;
+    b.add_term(x);
+    c = integer(1);
+    t1 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N; i++) {
+        b.add_term(mul(c, pow(x, integer(i))));
+        c = mul(c, integer(-1));
+    }
+    a = b.finish();
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "AddBuilder: "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+    std::cout << "number of terms: "
+        << rcp_dynamic_cast<const Add>(a)->dict_.size() << std::endl;
+
     return 0;
 }
@@ -0,0 +1,66 @@
+#include <iostream>
+#include <chrono>
+
+#include <symengine/polynomial.h>
+
+using SymEngine::UnivariatePolynomial;
+using SymEngine::DenseUniPoly;
+using SymEngine::RCP;
+using SymEngine::symbol;
+using SymEngine::mul_uni_poly;
+
+int main(int argc, char* argv[])
+{
+    SymEngine::print_stack_on_segfault();
+
+    RCP<const SymEngine::Symbol> x = symbol("x");
+    gmp_randclass r(gmp_randinit_default);
+    r.seed(1);
+
+    // Products of two polynomials of length n with positive coefficients
+    // (mul_uni_poly does not support mixed signs) of the given bits
+    for (unsigned bits : {8, 64, 1000}) {
+        for (unsigned n : {10, 30, 100, 300, 1000, 3000}) {
+            std::vector<mpz_class> a(n), b(n);
+            for (unsigned i = 0; i < n; i++) {
+                a[i] = r.get_z_bits(bits) + 1;
+                b[i] = r.get_z_bits(bits) + 1;
+            }
+            RCP<const UnivariatePolynomial> pa = UnivariatePolynomial::create(x, a);
+            RCP<const UnivariatePolynomial> pb = UnivariatePolynomial::create(x, b);
+            DenseUniPoly A(std::move(a)), B(std::move(b)), C;
+            unsigned reps = 300000 / n / (1 + bits / 64) + 1;
+
+            auto t1 = std::chrono::high_resolution_clock::now();
+            for (unsigned k = 0; k < reps; k++)
+                mul_uni_poly(pa, pb);
+            auto t2 = std::chrono::high_resolution_clock::now();
+            auto t_uni = std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count();
+
+            t1 = std::chrono::high_resolution_clock::now();
+            for (unsigned k = 0; k < reps; k++)
+                poly_mul(A, B, C);
+            t2 = std::chrono::high_resolution_clock::now();
+            auto t_dense = std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count();
+
+            t1 = std::chrono::high_resolution_clock::now();
+            for (unsigned k = 0; k < reps; k++)
+                poly_mul_karatsuba(A, B, C);
+            t2 = std::chrono::high_resolution_clock::now();
+            auto t_kara = std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count();
+
+            t1 = std::chrono::high_resolution_clock::now();
+            for (unsigned k = 0; k < reps; k++)
+                poly_mul_kronecker(A, B, C);
+            t2 = std::chrono::high_resolution_clock::now();
+            auto t_kron = std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count();
+
+            std::cout << "bits " << bits << ", n " << n << ", " << reps
+                << " times: mul_uni_poly " << t_uni << "ms, poly_mul "
+                << t_dense << "ms, karatsuba " << t_kara << "ms, kronecker "
+                << t_kron << "ms" << std::endl;
+        }
+    }
+
+    return 0;
+}
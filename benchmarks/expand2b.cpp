@@ -19,7 +19,8 @@ using SymEngine::Integer;
 using SymEngine::integer;
 using SymEngine::expr2poly;
 using SymEngine::poly_mul;
-using SymEngine::umap_vec_mpz;
+using SymEngine::poly_mul_heap;
+using SymEngine::SparsePoly;
 using SymEngine::RCP;
 using SymEngine::print_stack_on_segfault;
 
@@ -44,7 +45,7 @@ int main(int argc, char* argv[])
     insert(syms, z, integer(2));
     insert(syms, w, integer(3));
 
-    umap_vec_mpz P1, P2, C;
+    SparsePoly P1, P2, C;
 
     expr2poly(f1, syms, P1);
     expr2poly(f2, syms, P2);
@@ -68,7 +69,17 @@ int main(int argc, char* argv[])
         << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
         << "ms" << std::endl;
     std::cout << "number of terms: "
-        << C.size() << std::endl;
+        << C.dict.size() << std::endl;
+
+    SymEngine::vec_packed_mpz D;
+    t1 = std::chrono::high_resolution_clock::now();
+    poly_mul_heap(P1, P2, D);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "poly_mul_heap: "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+    std::cout << "number of terms: "
+        << D.size() << std::endl;
 
 
 
@@ -0,0 +1,62 @@
+#include <iostream>
+#include <chrono>
+
+#include <symengine/basic.h>
+#include <symengine/add.h>
+#include <symengine/symbol.h>
+#include <symengine/integer.h>
+#include <symengine/rings.h>
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+using SymEngine::symbol;
+using SymEngine::integer;
+using SymEngine::umap_basic_num;
+using SymEngine::SparsePoly;
+using SymEngine::vec_packed_mpz;
+using SymEngine::expr2poly;
+using SymEngine::poly_mul;
+using SymEngine::poly_mul_heap;
+
+// The polynomial version of expand6: (a0 + a1 + ... + a{N-1})**4, computed
+// as the square of the square, which is a product of two large operands.
+int main(int argc, char* argv[])
+{
+    SymEngine::print_stack_on_segfault();
+    int N;
+    if (argc == 2) {
+        N = std::atoi(argv[1]);
+    } else {
+        N = 32;
+    }
+
+    RCP<const Basic> e = integer(0);
+    umap_basic_num syms;
+    for (int i = 0; i < N; i++) {
+        RCP<const Basic> s = symbol("a" + std::to_string(i));
+        e = add(e, s);
+        insert(syms, s, integer(i));
+    }
+    SparsePoly P, P2, C1;
+    expr2poly(e, syms, P);
+    poly_mul(P, P, P2);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    poly_mul(P2, P2, C1);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "poly_mul:      "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+
+    vec_packed_mpz C2;
+    t1 = std::chrono::high_resolution_clock::now();
+    poly_mul_heap(P2, P2, C2);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "poly_mul_heap: "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+    std::cout << "number of terms: " << C1.dict.size() << " " << C2.size()
+        << std::endl;
+
+    return 0;
+}
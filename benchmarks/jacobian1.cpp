@@ -0,0 +1,61 @@
+#include <iostream>
+#include <chrono>
+
+#include <symengine/matrix.h>
+#include <symengine/add.h>
+#include <symengine/mul.h>
+#include <symengine/pow.h>
+#include <symengine/functions.h>
+#include <symengine/symbol.h>
+#include <symengine/integer.h>
+
+using SymEngine::Basic;
+using SymEngine::Symbol;
+using SymEngine::RCP;
+using SymEngine::DenseMatrix;
+using SymEngine::vec_basic;
+using SymEngine::symbol;
+using SymEngine::integer;
+using SymEngine::add;
+using SymEngine::mul;
+using SymEngine::pow;
+using SymEngine::sin;
+using SymEngine::rcp_static_cast;
+
+int main(int argc, char* argv[])
+{
+    SymEngine::print_stack_on_segfault();
+
+    // f_i = sin(s) * x_i + x_i * x_{i+1}**2, where s = x_0**2 + ... is
+    // shared by all the rows
+    const unsigned N = 200;
+    vec_basic x, f;
+    for (unsigned i = 0; i < N; i++)
+        x.push_back(symbol("x" + std::to_string(i)));
+    vec_basic squares;
+    for (unsigned i = 0; i < N; i++)
+        squares.push_back(pow(x[i], integer(2)));
+    RCP<const Basic> s = sin(add(squares));
+    for (unsigned i = 0; i < N; i++)
+        f.push_back(add(mul(s, x[i]),
+            mul(x[i], pow(x[(i + 1) % N], integer(2)))));
+    DenseMatrix A(N, 1, f), X(N, 1, x), J(N, N);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (unsigned i = 0; i < N; i++)
+        for (unsigned j = 0; j < N; j++)
+            J.set(i, j, f[i]->diff(rcp_static_cast<const Symbol>(x[j])));
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "Basic::diff " << N << "x" << N << ": "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    jacobian(A, X, J);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "jacobian " << N << "x" << N << ":    "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include <iostream>
+#include <chrono>
+
+#include <symengine/lambda_double.h>
+#include <symengine/lambda_bytecode.h>
+#include <symengine/lambda_jit.h>
+#include <symengine/matrix.h>
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+using SymEngine::symbol;
+using SymEngine::integer;
+using SymEngine::add;
+using SymEngine::mul;
+using SymEngine::pow;
+using SymEngine::div;
+using SymEngine::sin;
+using SymEngine::cos;
+using SymEngine::exp;
+using SymEngine::sqrt;
+using SymEngine::LambdaRealDoubleVisitor;
+using SymEngine::LambdaRealDoubleBytecode;
+using SymEngine::LambdaRealDoubleJIT;
+using SymEngine::LambdaRealDoubleGradient;
+using SymEngine::DenseMatrix;
+using SymEngine::vec_basic;
+
+int main(int argc, char* argv[])
+{
+    SymEngine::print_stack_on_segfault();
+
+    RCP<const Basic> x = symbol("x"), y = symbol("y"), z = symbol("z");
+    RCP<const Basic> e = add(sin(x), cos(mul(y, z)));
+    for (int i = 1; i < 20; i++) {
+        e = add(e, div(mul(integer(i), pow(x, integer(i % 5))),
+            add(integer(1), mul(y, y))));
+    }
+    e = add(e, mul(exp(div(x, integer(4))), sqrt(add(z, integer(2)))));
+
+    const std::size_t N = 2000000;
+    std::vector<double> xs(N), ys(N), zs(N), out(N);
+    for (std::size_t k = 0; k < N; k++) {
+        xs[k] = 0.5 + 1e-7 * k;
+        ys[k] = 1.0 - 1e-7 * k;
+        zs[k] = 2e-7 * k;
+    }
+    double sum;
+
+    LambdaRealDoubleVisitor v;
+    v.init({x, y, z}, *e);
+    sum = 0;
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (std::size_t k = 0; k < N; k++)
+        sum += v.call({xs[k], ys[k], zs[k]});
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "LambdaRealDoubleVisitor::call        "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms (sum = " << sum << ")" << std::endl;
+
+    LambdaRealDoubleBytecode b;
+    b.init({x, y, z}, *e);
+    sum = 0;
+    t1 = std::chrono::high_resolution_clock::now();
+    for (std::size_t k = 0; k < N; k++)
+        sum += b.call({xs[k], ys[k], zs[k]});
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "LambdaRealDoubleBytecode::call       "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms (sum = " << sum << ")" << std::endl;
+
+    const double *inputs[] = {xs.data(), ys.data(), zs.data()};
+    t1 = std::chrono::high_resolution_clock::now();
+    b.call_batch(inputs, out.data(), N);
+    t2 = std::chrono::high_resolution_clock::now();
+    sum = 0;
+    for (std::size_t k = 0; k < N; k++)
+        sum += out[k];
+    std::cout << "LambdaRealDoubleBytecode::call_batch "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms (sum = " << sum << ")" << std::endl;
+
+    LambdaRealDoubleJIT j;
+    j.init({x, y, z}, *e);
+    sum = 0;
+    t1 = std::chrono::high_resolution_clock::now();
+    for (std::size_t k = 0; k < N; k++)
+        sum += j.call({xs[k], ys[k], zs[k]});
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "LambdaRealDoubleJIT::call"
+        << (j.is_native() ? "            " : " (no compiler) ")
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms (sum = " << sum << ")" << std::endl;
+
+    // Gradient: symbolic derivatives compiled to bytecode against reverse
+    // mode on the bytecode of the expression itself
+    DenseMatrix A(1, 1, {e}), X(3, 1, {x, y, z}), J(1, 3);
+    double in[3], grad[3];
+    t1 = std::chrono::high_resolution_clock::now();
+    jacobian(A, X, J);
+    b.init({x, y, z}, J);
+    sum = 0;
+    for (std::size_t k = 0; k < N; k++) {
+        in[0] = xs[k]; in[1] = ys[k]; in[2] = zs[k];
+        b.call(grad, in);
+        sum += grad[0] + grad[1] + grad[2];
+    }
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "jacobian + LambdaRealDoubleBytecode  "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms (sum = " << sum << ")" << std::endl;
+
+    LambdaRealDoubleGradient g;
+    t1 = std::chrono::high_resolution_clock::now();
+    g.init({x, y, z}, *e);
+    sum = 0;
+    for (std::size_t k = 0; k < N; k++) {
+        in[0] = xs[k]; in[1] = ys[k]; in[2] = zs[k];
+        g.call_gradient(in, grad);
+        sum += grad[0] + grad[1] + grad[2];
+    }
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "LambdaRealDoubleGradient             "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms (sum = " << sum << ")" << std::endl;
+
+    // A chain over many symbols, where the symbolic gradient is quadratic in
+    // the number of symbols
+    const unsigned n = 100;
+    const std::size_t M = 10000;
+    vec_basic syms;
+    for (unsigned i = 0; i < n; i++)
+        syms.push_back(symbol("x" + std::to_string(i)));
+    RCP<const Basic> c = syms[0];
+    for (unsigned i = 1; i < n; i++)
+        c = sin(add(mul(c, syms[i]), syms[i - 1]));
+    std::vector<double> ins(n), grads(n);
+    for (unsigned i = 0; i < n; i++)
+        ins[i] = 0.5 + 0.01 * i;
+
+    DenseMatrix C(1, 1, {c}), S(n, 1, syms), JC(1, n);
+    t1 = std::chrono::high_resolution_clock::now();
+    jacobian(C, S, JC);
+    b.init(syms, JC);
+    sum = 0;
+    for (std::size_t k = 0; k < M; k++) {
+        ins[0] = 1e-5 * k;
+        b.call(grads.data(), ins.data());
+        sum += grads[0];
+    }
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "chain of " << n << ": jacobian + bytecode   "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms (sum = " << sum << ")" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    g.init(syms, *c);
+    sum = 0;
+    for (std::size_t k = 0; k < M; k++) {
+        ins[0] = 1e-5 * k;
+        g.call_gradient(ins.data(), grads.data());
+        sum += grads[0];
+    }
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "chain of " << n << ": LambdaRealDoubleGradient "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms (sum = " << sum << ")" << std::endl;
+
+    return 0;
+}
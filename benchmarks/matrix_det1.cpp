@@ -0,0 +1,74 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+
+#include <symengine/matrix.h>
+#include <symengine/numeric_matrix.h>
+#include <symengine/integer.h>
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+using SymEngine::integer;
+using SymEngine::DenseMatrix;
+using SymEngine::IntegerDenseMatrix;
+using SymEngine::vec_basic;
+
+int main(int argc, char* argv[])
+{
+    SymEngine::print_stack_on_segfault();
+
+    unsigned n;
+    if (argc == 2) {
+        n = std::atoi(argv[1]);
+    } else {
+        n = 40;
+    }
+
+    // Entries in [-99, 99] from a linear congruential generator
+    unsigned long g = 12345;
+    vec_basic a;
+    IntegerDenseMatrix B(n, n);
+    for (unsigned i = 0; i < n*n; i++) {
+        g = (g * 1103515245 + 12345) % 2147483648UL;
+        long e = long((g >> 8) % 199) - 99;
+        a.push_back(integer(e));
+        B.m_[i] = e;
+    }
+    DenseMatrix A(n, n, a);
+
+    std::cout << "matrix dimensions: " << n << " x " << n << std::endl;
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    RCP<const Basic> d1 = det_berkowitz(A);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "det_berkowitz      "
+        << std::chrono::duration_cast<std::chrono::microseconds>(t2-t1).count()
+        << "us" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    RCP<const Basic> d2 = det_bareis(A);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "det_bareis         "
+        << std::chrono::duration_cast<std::chrono::microseconds>(t2-t1).count()
+        << "us" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    mpz_class d3 = det_fraction_free(B);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "det_fraction_free  "
+        << std::chrono::duration_cast<std::chrono::microseconds>(t2-t1).count()
+        << "us" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    mpz_class d4 = det_modular(B);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "det_modular        "
+        << std::chrono::duration_cast<std::chrono::microseconds>(t2-t1).count()
+        << "us" << std::endl;
+
+    if (not eq(*d1, *d2) or not eq(*d1, *integer(d3)) or d3 != d4) {
+        std::cout << "The determinants differ" << std::endl;
+        return 1;
+    }
+    return 0;
+}
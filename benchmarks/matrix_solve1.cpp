@@ -0,0 +1,88 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+
+#include <symengine/matrix.h>
+#include <symengine/integer.h>
+#include <symengine/rational.h>
+#include <symengine/real_double.h>
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+using SymEngine::integer;
+using SymEngine::real_double;
+using SymEngine::Rational;
+using SymEngine::DenseMatrix;
+using SymEngine::vec_basic;
+
+int main(int argc, char* argv[])
+{
+    SymEngine::print_stack_on_segfault();
+
+    unsigned n;
+    if (argc == 2) {
+        n = std::atoi(argv[1]);
+    } else {
+        n = 100;
+    }
+
+    // Entries `p/q` with `|p| < 10` and `0 < q < 5` from a linear
+    // congruential generator
+    unsigned long g = 12345;
+    auto next = [&g](unsigned long m) {
+        g = (g * 1103515245 + 12345) % 2147483648UL;
+        return long((g >> 8) % m);
+    };
+    vec_basic a, r, d, b, bd;
+    for (unsigned i = 0; i < n*n; i++) {
+        long p = next(19) - 9, q = next(4) + 1;
+        a.push_back(Rational::from_two_ints(p, q));
+        r.push_back(integer(p));
+        d.push_back(real_double(double(p) / q));
+    }
+    for (unsigned i = 0; i < n; i++) {
+        b.push_back(integer(next(19) - 9));
+        bd.push_back(real_double(double(next(19) - 9)));
+    }
+    DenseMatrix A(n, n, a), R(n, n, r), D(n, n, d), B(n, 1, b), BD(n, 1, bd);
+    DenseMatrix X(n, 1), Y(n, n);
+
+    std::cout << "matrix dimensions: " << n << " x " << n << std::endl;
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    RCP<const Basic> det = R.det();
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "integer det          "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    det = A.det();
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "rational det         "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    LU_solve(A, B, X);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "rational LU_solve    "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    inverse_LU(R, Y);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "integer inverse_LU   "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    LU_solve(D, BD, X);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "double LU_solve      "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+
+    return 0;
+}
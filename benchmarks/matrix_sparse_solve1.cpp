@@ -0,0 +1,104 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+
+#include <symengine/matrix.h>
+#include <symengine/integer.h>
+#include <symengine/real_double.h>
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+using SymEngine::integer;
+using SymEngine::real_double;
+using SymEngine::DenseMatrix;
+using SymEngine::CSRMatrix;
+using SymEngine::CSRSymbolicLU;
+using SymEngine::vec_basic;
+
+int main(int argc, char* argv[])
+{
+    SymEngine::print_stack_on_segfault();
+
+    unsigned k;
+    if (argc == 2) {
+        k = std::atoi(argv[1]);
+    } else {
+        k = 20;
+    }
+    unsigned n = k*k;
+
+    // Five point stencil on a `k` by `k` grid, with a varying diagonal
+    std::vector<unsigned> i, j;
+    vec_basic a, d, b, bd;
+    for (unsigned r = 0; r < n; r++) {
+        unsigned x = r % k, y = r / k;
+        auto entry = [&](unsigned c, long v) {
+            i.push_back(r);
+            j.push_back(c);
+            a.push_back(integer(v));
+            d.push_back(real_double(v));
+        };
+        entry(r, 4 + r % 3);
+        if (x > 0) entry(r - 1, -1);
+        if (x + 1 < k) entry(r + 1, -1);
+        if (y > 0) entry(r - k, -1);
+        if (y + 1 < k) entry(r + k, -1);
+        b.push_back(integer(r % 7));
+        bd.push_back(real_double(r % 7));
+    }
+    CSRMatrix A = CSRMatrix::from_coo(n, n, i, j, a);
+    CSRMatrix D = CSRMatrix::from_coo(n, n, i, j, d);
+    DenseMatrix B(n, 1, b), BD(n, 1, bd), X(n, 1), DA(n, n);
+    for (unsigned r = 0; r < n; r++)
+        for (unsigned c = 0; c < n; c++)
+            DA.set(r, c, A.get(r, c));
+
+    std::cout << "matrix dimensions: " << n << " x " << n << ", nnz: "
+        << a.size() << std::endl;
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    CSRSymbolicLU S = CSRSymbolicLU(A);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "symbolic analysis        "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms, nnz(L+U): " << S.lp_[n] + S.up_[n] << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    CSRSymbolicLU N = CSRSymbolicLU(A, false);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "natural order analysis   "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms, nnz(L+U): " << N.lp_[n] + N.up_[n] << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    RCP<const Basic> det = csr_det(S, A);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "integer sparse det       "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    csr_LU_solve(S, A, B, X);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "integer sparse LU_solve  "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    LU_solve(DA, B, X);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "integer dense LU_solve   "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+
+    // Refactorizations of matrices with the pattern of `A` reuse `S`
+    t1 = std::chrono::high_resolution_clock::now();
+    for (unsigned t = 0; t < 10; t++)
+        csr_LU_solve(S, D, BD, X);
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "double sparse LU_solve   "
+        << std::chrono::duration_cast<std::chrono::microseconds>(t2-t1).count() / 10
+        << "us" << std::endl;
+
+    return 0;
+}
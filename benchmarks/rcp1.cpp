@@ -0,0 +1,58 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <thread>
+
+#include <symengine/basic.h>
+#include <symengine/symbol.h>
+
+using SymEngine::Basic;
+using SymEngine::RCP;
+using SymEngine::symbol;
+
+// Copies all of `v` into `w` and destroys the copies, `n` times
+static void copy_destroy(const std::vector<RCP<const Basic>> &v,
+    std::vector<RCP<const Basic>> &w, int n)
+{
+    for (int k = 0; k < n; k++) {
+        for (std::size_t i = 0; i < v.size(); i++)
+            w[i] = v[i];
+        for (std::size_t i = 0; i < v.size(); i++)
+            w[i].reset();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    SymEngine::print_stack_on_segfault();
+
+    int N;
+    if (argc == 2) {
+        N = std::atoi(argv[1]);
+    } else {
+        N = 100000;
+    }
+
+    std::vector<RCP<const Basic>> v, w(1000);
+    for (int i = 0; i < 1000; i++)
+        v.push_back(symbol("x" + std::to_string(i)));
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    copy_destroy(v, w, N);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "copy + destroy in the creating thread "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+
+#if defined(WITH_SYMENGINE_THREAD_SAFE)
+    t1 = std::chrono::high_resolution_clock::now();
+    std::thread other(copy_destroy, std::cref(v), std::ref(w), N);
+    other.join();
+    t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "copy + destroy in another thread      "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+        << "ms" << std::endl;
+#endif
+
+    return 0;
+}
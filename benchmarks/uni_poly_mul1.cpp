@@ -0,0 +1,44 @@
+#include <iostream>
+#include <chrono>
+
+#include <symengine/polynomial.h>
+
+using SymEngine::UnivariatePolynomial;
+using SymEngine::RCP;
+using SymEngine::symbol;
+using SymEngine::mul_uni_poly;
+
+int main(int argc, char* argv[])
+{
+    SymEngine::print_stack_on_segfault();
+
+    RCP<const SymEngine::Symbol> x = symbol("x");
+    gmp_randclass r(gmp_randinit_default);
+    r.seed(1);
+
+    // Products of dense polynomials of increasing degree, with positive
+    // coefficients of the given bits
+    for (unsigned bits : {16, 256}) {
+        for (unsigned n : {10, 100, 1000, 3000, 10000, 30000}) {
+            std::vector<mpz_class> a(n), b(n);
+            for (unsigned i = 0; i < n; i++) {
+                a[i] = r.get_z_bits(bits) + 1;
+                b[i] = r.get_z_bits(bits) + 1;
+            }
+            RCP<const UnivariatePolynomial> pa = UnivariatePolynomial::create(x, a);
+            RCP<const UnivariatePolynomial> pb = UnivariatePolynomial::create(x, b);
+            unsigned reps = 100000 / n + 1;
+
+            auto t1 = std::chrono::high_resolution_clock::now();
+            for (unsigned k = 0; k < reps; k++)
+                mul_uni_poly(pa, pb);
+            auto t2 = std::chrono::high_resolution_clock::now();
+            std::cout << "bits " << bits << ", degree " << n - 1 << ", " << reps
+                << " times: "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
+                << "ms" << std::endl;
+        }
+    }
+
+    return 0;
+}
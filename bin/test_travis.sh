@@ -36,6 +36,15 @@ fi
 if [[ "${WITH_SYMENGINE_THREAD_SAFE}" != "" ]]; then
     cmake_line="$cmake_line -DWITH_SYMENGINE_THREAD_SAFE=${WITH_SYMENGINE_THREAD_SAFE}"
 fi
+if [[ "${WITH_SYMENGINE_POOL}" != "" ]]; then
+    cmake_line="$cmake_line -DWITH_SYMENGINE_POOL=${WITH_SYMENGINE_POOL}"
+fi
+if [[ "${WITH_OPENMP}" != "" ]]; then
+    cmake_line="$cmake_line -DWITH_OPENMP=${WITH_OPENMP}"
+fi
+if [[ "${WITH_SYMENGINE_PARALLEL_EXPAND}" != "" ]]; then
+    cmake_line="$cmake_line -DWITH_SYMENGINE_PARALLEL_EXPAND=${WITH_SYMENGINE_PARALLEL_EXPAND}"
+fi
 if [[ "${WITH_ECM}" != "" ]]; then
     cmake_line="$cmake_line -DWITH_ECM=${WITH_ECM}"
 fi
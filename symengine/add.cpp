@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <symengine/basic.h>
 #include <symengine/add.h>
 #include <symengine/symbol.h>
@@ -5,6 +7,7 @@
 #include <symengine/pow.h>
 #include <symengine/complex.h>
 #include <symengine/functions.h>
+#include <symengine/visitor.h>
 
 
 namespace SymEngine {
@@ -83,12 +86,27 @@ int Add::compare(const Basic &o) const
     if (cmp != 0)
         return cmp;
 
-    // Compare dictionaries:
-    // NOTE: This is slow. Add should cache this map_basic_num representation
-    // once it is computed.
-    map_basic_num adict(dict_.begin(), dict_.end());
-    map_basic_num bdict(s.dict_.begin(), s.dict_.end());
-    return map_compare(adict, bdict);
+    // Compare dictionaries in the order of map_basic_num, sorting pointers to
+    // the terms instead of building the maps
+    typedef const umap_basic_num::value_type *term_ptr;
+    auto sorted = [](const umap_basic_num &d) {
+        std::vector<term_ptr> v;
+        v.reserve(d.size());
+        for (const auto &p: d)
+            v.push_back(&p);
+        std::sort(v.begin(), v.end(), [](term_ptr a, term_ptr b) {
+            return RCPBasicKeyLess()(a->first, b->first);
+        });
+        return v;
+    };
+    std::vector<term_ptr> a = sorted(dict_), b = sorted(s.dict_);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        cmp = a[i]->first->__cmp__(*b[i]->first);
+        if (cmp != 0) return cmp;
+        cmp = a[i]->second->__cmp__(*b[i]->second);
+        if (cmp != 0) return cmp;
+    }
+    return 0;
 }
 
 // Very quickly (!) creates the appropriate instance (i.e. Add, Symbol,
@@ -110,7 +128,8 @@ RCP<const Basic> Add::from_dict(const RCP<const Number> &coef, umap_basic_num &&
                 return p->first;
             }
             if (is_a<Mul>(*(p->first))) {
-#if !defined(WITH_SYMENGINE_THREAD_SAFE) and defined(WITH_SYMENGINE_RCP)
+#if !defined(WITH_SYMENGINE_THREAD_SAFE) and defined(WITH_SYMENGINE_RCP) \
+    and !defined(WITH_SYMENGINE_INTERN)
                 if (rcp_static_cast<const Mul>(p->first)->use_count() == 1) {
                     // We can steal the dictionary:
                     // Cast away const'ness, so that we can move 'dict_', since
@@ -139,12 +158,13 @@ RCP<const Basic> Add::from_dict(const RCP<const Number> &coef, umap_basic_num &&
             } else {
                 insert(m, p->first, one);
             }
-            return make_rcp<const Mul>(p->second, std::move(m));
+            return intern(make_rcp<const Mul>(p->second, std::move(m)));
         }
         map_basic_basic m;
         if (is_a_Number(*p->second)) {
             if (is_a<Mul>(*(p->first))) {
-#if !defined(WITH_SYMENGINE_THREAD_SAFE) and defined(WITH_SYMENGINE_RCP)
+#if !defined(WITH_SYMENGINE_THREAD_SAFE) and defined(WITH_SYMENGINE_RCP) \
+    and !defined(WITH_SYMENGINE_INTERN)
                 if (rcp_static_cast<const Mul>(p->first)->use_count() == 1) {
                     // We can steal the dictionary:
                     // Cast away const'ness, so that we can move 'dict_', since
@@ -172,14 +192,14 @@ RCP<const Basic> Add::from_dict(const RCP<const Number> &coef, umap_basic_num &&
             } else {
                 insert(m, p->first, one);
             }
-            return make_rcp<const Mul>(p->second, std::move(m));
+            return intern(make_rcp<const Mul>(p->second, std::move(m)));
         } else {
             insert(m, p->first, one);
             insert(m, p->second, one);
-            return make_rcp<const Mul>(one, std::move(m));
+            return intern(make_rcp<const Mul>(one, std::move(m)));
         }
     } else {
-        return make_rcp<const Add>(coef, std::move(d));
+        return intern(make_rcp<const Add>(coef, std::move(d)));
     }
 }
 
@@ -290,6 +310,54 @@ RCP<const Basic> add(const RCP<const Basic> &a, const RCP<const Basic> &b)
     return Add::from_dict(coef, std::move(d));
 }
 
+RCP<const Basic> add(const vec_basic &a)
+{
+    AddBuilder b;
+    for (const auto &p: a)
+        b.add_term(p);
+    return b.finish();
+}
+
+AddBuilder::AddBuilder() : coef_{zero}
+{
+}
+
+AddBuilder::AddBuilder(RCP<const Basic> &&a) : coef_{zero}
+{
+    // Take over the reference, so that an Add whose dictionary was stolen
+    // is released here.
+    RCP<const Basic> t = std::move(a);
+    if (not is_a<Add>(*t)) {
+        add_term(t);
+        return;
+    }
+    const Add &s = static_cast<const Add &>(*t);
+    coef_ = s.coef_;
+#if !defined(WITH_SYMENGINE_THREAD_SAFE) and defined(WITH_SYMENGINE_RCP) \
+    and !defined(WITH_SYMENGINE_INTERN)
+    if (t->use_count() == 1) {
+        // Nobody else is using the Add, so we can steal its dictionary, see
+        // the same optimization in Add::from_dict().
+        dict_ = std::move(const_cast<umap_basic_num &>(s.dict_));
+        return;
+    }
+#endif
+    dict_ = s.dict_;
+}
+
+void AddBuilder::add_term(const RCP<const Basic> &term)
+{
+    Add::coef_dict_add_term(outArg(coef_), dict_, one, term);
+}
+
+RCP<const Basic> AddBuilder::finish()
+{
+    RCP<const Basic> r = Add::from_dict(coef_, std::move(dict_));
+    coef_ = zero;
+    dict_.clear();
+    return r;
+}
+
 RCP<const Basic> sub(const RCP<const Basic> &a, const RCP<const Basic> &b)
 {
     return add(a, mul(minus_one, b));
@@ -307,37 +375,7 @@ void Add::as_two_terms(const Ptr<RCP<const Basic>> &a,
 
 RCP<const Basic> Add::subs(const map_basic_basic &subs_dict) const
 {
-    RCP<const Add> self = rcp_from_this_cast<const Add>();
-    auto it = subs_dict.find(self);
-    if (it != subs_dict.end())
-        return it->second;
-
-    SymEngine::umap_basic_num d;
-    RCP<const Number> coef;
-
-    it = subs_dict.find(coef_);
-    if (it != subs_dict.end()) {
-        coef = zero;
-        coef_dict_add_term(outArg(coef), d, one, it->second);
-    } else {
-        coef = coef_;
-    }
-
-    for (const auto &p: dict_) {
-        auto it = subs_dict.find(Add::from_dict(zero, {{p.first, p.second}}));
-        if (it != subs_dict.end()) {
-            coef_dict_add_term(outArg(coef), d, one, it->second);
-        } else {
-            it = subs_dict.find(p.second);
-            if (it != subs_dict.end()) {
-                coef_dict_add_term(outArg(coef), d, one, mul(it->second, p.first->subs(subs_dict)));
-            } else {
-                coef_dict_add_term(outArg(coef), d, p.second, p.first->subs(subs_dict));
-            }
-        }
-    }
-
-    return Add::from_dict(coef, std::move(d));
+    return SubsVisitor(subs_dict).apply(rcp_from_this());
 }
 
 vec_basic Add::get_args() const {
@@ -349,4 +387,12 @@ vec_basic Add::get_args() const {
     return args;
 }
 
+void Add::for_each_arg(const ArgFunction &f) const {
+    if (not coef_->is_exact_zero()) f(*coef_);
+    for (const auto &p: dict_) {
+        f(*p.first);
+        f(*p.second);
+    }
+}
+
 } // SymEngine
@@ -63,11 +63,41 @@ public:
     virtual RCP<const Basic> subs(const map_basic_basic &subs_dict) const;
 
     virtual vec_basic get_args() const;
+    virtual void for_each_arg(const ArgFunction &f) const;
+};
+
+/*! Accumulates a sum in a mutable dictionary, which is canonicalized only
+    once by `finish()`. Adding `n` terms one by one with `add(a, b)` copies
+    the dictionary of the partial sum every time, which is quadratic in `n`;
+    the builder is linear:
+
+        AddBuilder b;
+        for (const auto &t: terms) b.add_term(t);
+        RCP<const Basic> r = b.finish();
+*/
+class AddBuilder {
+private:
+    RCP<const Number> coef_;
+    umap_basic_num dict_;
+public:
+    //! Starts with the sum `0`
+    AddBuilder();
+    /*! Starts with the sum `a`. If `a` is an Add and this is its only
+        reference, its dictionary is moved into the builder instead of
+        copied. `a` is null afterwards.
+    */
+    explicit AddBuilder(RCP<const Basic> &&a);
+    //! Adds `term` to the sum
+    void add_term(const RCP<const Basic> &term);
+    //! \return the canonical sum, the builder starts again from `0`
+    RCP<const Basic> finish();
 };
 
 //! \return Add made from `a + b`
 RCP<const Basic> add(const RCP<const Basic> &a,
         const RCP<const Basic> &b);
+//! \return Add made from the sum of all the elements of `a`
+RCP<const Basic> add(const vec_basic &a);
 //! \return Add made from `a - b`
 RCP<const Basic> sub(const RCP<const Basic> &a,
         const RCP<const Basic> &b);
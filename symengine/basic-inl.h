@@ -19,12 +19,17 @@ inline bool Basic::__neq__(const Basic &o) const
 //! \return true if  `a` equal `b`
 inline bool eq(const Basic &a, const Basic &b)
 {
+    if (&a == &b) return true;
+#if defined(WITH_SYMENGINE_INTERN)
+    // An intern table holds only one instance of each value
+    if (a.is_interned_with(b)) return false;
+#endif
     return a.__eq__(b);
 }
 //! \return true if  `a` not equal `b`
 inline bool neq(const Basic &a, const Basic &b)
 {
-    return not (a.__eq__(b));
+    return not eq(a, b);
 }
 
 //! Templatised version to check is_a type
@@ -40,6 +45,44 @@ inline bool is_a_sub(const Basic &b)
     return dynamic_cast<const T *>(&b) != nullptr;
 }
 
+template <class T>
+inline std::size_t stable_hash(const T& v)
+{
+    return std::hash<T>()(v);
+}
+
+template <>
+inline std::size_t stable_hash<std::string>(const std::string& v)
+{
+    return hash_bytes(v.data(), v.size());
+}
+
+template <>
+inline std::size_t stable_hash<double>(const double& v)
+{
+    // All zeros hash the same, as they compare equal
+    if (v == 0.0) return 0;
+    // The bytes of the representation in little endian order
+    std::uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    unsigned char bytes[sizeof(bits)];
+    for (unsigned k = 0; k < sizeof(bits); k++)
+        bytes[k] = static_cast<unsigned char>(bits >> (8 * k));
+    return hash_bytes(bytes, sizeof(bytes));
+}
+
+template <>
+inline std::size_t stable_hash<long long int>(const long long int& v)
+{
+    return static_cast<std::size_t>(v);
+}
+
+template <>
+inline std::size_t stable_hash<unsigned int>(const unsigned int& v)
+{
+    return static_cast<std::size_t>(v);
+}
+
 } // SymEngine
 
 // global namespace functions
@@ -53,8 +96,7 @@ inline std::ostream& operator<<(std::ostream& out, const SymEngine::Basic& p)
 template <class T>
 inline void hash_combine(std::size_t& seed, const T& v)
 {
-    std::hash<T> hasher;
-    seed ^= hasher(v) + 0x9e3779b9 + (seed<<6) + (seed>>2);
+    seed ^= SymEngine::stable_hash<T>(v) + 0x9e3779b9 + (seed<<6) + (seed>>2);
 }
 
 // std namespace functions
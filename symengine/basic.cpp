@@ -10,9 +10,80 @@
 #include <symengine/functions.h>
 #include <symengine/polynomial.h>
 #include <symengine/printer.h>
+#if defined(WITH_SYMENGINE_INTERN)
+#    include <mutex>
+#endif
 
 namespace SymEngine {
 
+#if defined(WITH_SYMENGINE_INTERN)
+//! Instances stored by intern(), keyed by hash. It is locked because an
+//! instance is removed by the thread that releases it.
+struct InternTable {
+    std::mutex lock;
+    std::unordered_multimap<std::size_t, const Basic *> map;
+};
+
+//! \return the intern table used by the current thread
+static InternTable &current_intern_table()
+{
+    // Never destroyed: interned instances held by static variables can be
+    // released after the thread local storage is gone, and instances can
+    // outlive the thread that interned them.
+#if defined(WITH_SYMENGINE_INTERN_GLOBAL)
+    static InternTable *table = new InternTable;
+#else
+    static thread_local InternTable *table = new InternTable;
+#endif
+    return *table;
+}
+
+RCP<const Basic> intern(RCP<const Basic> x)
+{
+    if (x->is_interned()) return x;
+    InternTable &table = current_intern_table();
+    std::size_t h = x->hash();
+    // Declared before the guard, so that they are released after unlocking:
+    // releasing the last reference removes the instance from the table.
+    vec_basic unequal;
+    std::lock_guard<std::mutex> guard(table.lock);
+    auto range = table.map.equal_range(h);
+    for (auto it = range.first; it != range.second; ++it) {
+        // An instance whose last reference is gone is being destroyed by
+        // another thread, which waits for the lock to remove it
+        RCP<const Basic> y = it->second->rcp_from_this_if_alive();
+        if (y.is_null()) continue;
+        if (y->__eq__(*x)) return y;
+        unequal.push_back(std::move(y));
+    }
+    table.map.insert(std::make_pair(h, x.get()));
+    x->intern_table_ = &table;
+    return x;
+}
+
+std::size_t intern_table_size()
+{
+    InternTable &table = current_intern_table();
+    std::lock_guard<std::mutex> guard(table.lock);
+    return table.map.size();
+}
+
+Basic::~Basic()
+{
+    if (intern_table_ == nullptr) return;
+    InternTable &table = *intern_table_;
+    std::size_t h = hash_;
+    std::lock_guard<std::mutex> guard(table.lock);
+    auto range = table.map.equal_range(h);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == this) {
+            table.map.erase(it);
+            return;
+        }
+    }
+}
+#endif
+
 int Basic::__cmp__(const Basic &o) const
 {
     auto a = this->get_type_code();
@@ -47,5 +118,37 @@ RCP<const Basic> Basic::diff(const RCP<const Symbol> &x) const
     return Derivative::create(rcp_from_this(), {x});
 }
 
+void Basic::for_each_arg(const ArgFunction &f) const
+{
+    for (const auto &p: get_args()) f(*p);
+}
+
+std::size_t hash_bytes(const void *p, std::size_t len)
+{
+    // MurmurHash64A as used by libstdc++, reading the bytes as little endian
+    const std::uint64_t mul = (std::uint64_t(0xc6a4a793UL) << 32)
+        + std::uint64_t(0x5bd1e995UL);
+    const unsigned char *buf = static_cast<const unsigned char *>(p);
+    auto shift_mix = [](std::uint64_t v) { return v ^ (v >> 47); };
+    auto load = [](const unsigned char *b, std::size_t n) {
+        std::uint64_t r = 0;
+        while (n-- != 0)
+            r = (r << 8) + b[n];
+        return r;
+    };
+    std::uint64_t hash = std::uint64_t(0xc70f6907UL) ^ (len * mul);
+    std::size_t aligned = len & ~std::size_t(7);
+    for (std::size_t i = 0; i < aligned; i += 8) {
+        hash ^= shift_mix(load(buf + i, 8) * mul) * mul;
+        hash *= mul;
+    }
+    if ((len & 7) != 0) {
+        hash ^= load(buf + aligned, len & 7);
+        hash *= mul;
+    }
+    hash = shift_mix(hash) * mul;
+    return static_cast<std::size_t>(shift_mix(hash));
+}
+
 } // SymEngine
 
@@ -24,6 +24,8 @@
 #include <vector>
 #include <type_traits>
 #include <functional>
+#include <cstdint>
+#include <cstring>
 
 #include <symengine/symengine_config.h>
 
@@ -34,11 +36,17 @@
 #include <symengine/symengine_assert.h>
 #include <symengine/symengine_rcp.h>
 #include <symengine/dict.h>
+#if defined(WITH_SYMENGINE_POOL)
+#    include <symengine/pool.h>
+#endif
 
 namespace SymEngine {
 
 class Visitor;
 class Symbol;
+#if defined(WITH_SYMENGINE_INTERN)
+struct InternTable;
+#endif
 
 /*!
     Any Basic class can be used in a "dictionary", due to the methods:
@@ -85,6 +93,33 @@ enum TypeID {
 
 #include "basic-methods.inc"
 
+class Basic;
+
+/*! Non-owning reference to a function called on each argument by
+    Basic::for_each_arg(). It neither copies nor allocates the function, so
+    a lambda can be passed directly:
+
+        b.for_each_arg([&](const Basic &arg) { ... });
+*/
+class ArgFunction {
+private:
+    void *f_;
+    void (*call_)(void *, const Basic &);
+
+    template<class F>
+    static void call(void *f, const Basic &arg) {
+        (*static_cast<F *>(f))(arg);
+    }
+public:
+    template<class F, class = typename std::enable_if<not std::is_same<
+        typename std::decay<F>::type, ArgFunction>::value>::type>
+    ArgFunction(F &&f)
+        : f_{const_cast<void *>(static_cast<const void *>(&f))},
+          call_{&call<typename std::remove_reference<F>::type>} {}
+
+    inline void operator()(const Basic &arg) const { call_(f_, arg); }
+};
+
 class Basic : public EnableRCPFromThis<Basic> {
 private:
     //! Private variables
@@ -97,13 +132,42 @@ private:
 #else
     mutable std::size_t hash_; // This holds the hash value
 #endif // WITH_SYMENGINE_THREAD_SAFE
+#if defined(WITH_SYMENGINE_INTERN)
+    // The intern table storing this instance as the one for its value, or
+    // nullptr, see intern(). It is the table of the thread that interned it,
+    // which need not be the thread that releases it.
+    mutable InternTable *intern_table_;
+    friend RCP<const Basic> intern(RCP<const Basic> x);
+#endif
 public:
     virtual TypeID get_type_code() const = 0;
     //! Constructor
+#if defined(WITH_SYMENGINE_INTERN)
+    Basic() : hash_{0}, intern_table_{nullptr} {}
+    //! Removes the instance from the intern table
+    virtual ~Basic();
+    //! \return true if this instance is stored in an intern table
+    inline bool is_interned() const { return intern_table_ != nullptr; }
+    //! \return true if this and `o` are stored in the same intern table
+    inline bool is_interned_with(const Basic &o) const {
+        return intern_table_ != nullptr and intern_table_ == o.intern_table_;
+    }
+#else
     Basic() : hash_{0} {}
     //! Destructor must be explicitly defined as virtual here to avoid problems
     //! with undefined behavior while deallocating derived classes.
     virtual ~Basic() {}
+#endif
+
+#if defined(WITH_SYMENGINE_POOL)
+    //! Instances are allocated from the pool of the thread, see pool.h
+    static void *operator new(std::size_t size) {
+        return pool_allocate(size);
+    }
+    static void operator delete(void *p, std::size_t size) {
+        pool_deallocate(p, size);
+    }
+#endif
 
     //! Delete the copy constructor and assignment
     Basic(const Basic&) = delete;
@@ -157,9 +221,26 @@ public:
     //! Returns the list of arguments
     virtual vec_basic get_args() const = 0;
 
+    /*! Calls `f` on each argument as stored, without creating any object,
+        which `get_args()` does for Add and Mul: for these the arguments are
+        the coefficient (unless it is `0` in Add and `1` in Mul) followed by
+        the key and the value of each pair of the dictionary, e.g. `x`, `2`
+        for the term `2*x` of an Add and for the factor `x**2` of a Mul.
+
+        The default calls `f` on the elements of `get_args()`.
+    */
+    virtual void for_each_arg(const ArgFunction &f) const;
+
     SYMENGINE_INCLUDE_METHODS(=0)
 };
 
+// Convenience functions
+//! Checks equality for `a` and `b`
+bool eq(const Basic &a, const Basic &b);
+
+//! Checks inequality for `a` and `b`
+bool neq(const Basic &a, const Basic &b);
+
 //! Our hash:
 struct RCPBasicHash {
     //! Returns the hashed value.
@@ -172,7 +253,7 @@ struct RCPBasicHash {
 struct RCPBasicKeyEq {
     //! Comparison Operator `==`
     bool operator() (const RCP<const Basic> &x, const RCP<const Basic> &y) const {
-        return x->__eq__(*y);
+        return eq(*x, *y);
     }
 };
 
@@ -180,9 +261,11 @@ struct RCPBasicKeyEq {
 struct RCPBasicKeyLess {
     //! true if `x < y`, false otherwise
     bool operator() (const RCP<const Basic> &x, const RCP<const Basic> &y) const {
+        if (x.get() == y.get()) return false;
+        // The cached hashes are platform independent, see stable_hash()
         std::size_t xh=x->hash(), yh=y->hash();
         if (xh != yh) return xh < yh;
-        if (x->__eq__(*y)) return false;
+        if (eq(*x, *y)) return false;
         return x->__cmp__(*y) == -1;
     }
 };
@@ -191,18 +274,14 @@ struct RCPBasicKeyLess {
 struct RCPBasicKeyLessCmp {
     //! true if `x < y`, false otherwise
     bool operator() (const RCP<const Basic> &x, const RCP<const Basic> &y) const {
-        if (x->__eq__(*y)) return false;
+        if (x.get() == y.get()) return false;
+        // __cmp__() decides on the type codes and the sizes of Add and Mul
+        // first, and returns 0 for equal instances, so there is no need to
+        // walk both trees with eq() before
         return x->__cmp__(*y) == -1;
     }
 };
 
-// Convenience functions
-//! Checks equality for `a` and `b`
-bool eq(const Basic &a, const Basic &b);
-
-//! Checks inequality for `a` and `b`
-bool neq(const Basic &a, const Basic &b);
-
 /*! Returns true if `b` is exactly of type `T`. Example:
   `is_a<Symbol>(b)` : true if "b" is of type Symbol
 */
@@ -216,9 +295,43 @@ template <class T> bool is_a(const Basic &b);
 template <class T>
 bool is_a_sub(const Basic &b);
 
+#if defined(WITH_SYMENGINE_INTERN)
+/*! Hash-consing of expressions: \return the instance equal to `x` which is
+    stored in the intern table, storing `x` itself if there is none. Add(),
+    mul() and pow() intern their results, so that equal expressions share one
+    allocation and `eq()` of two instances from the same table is a pointer
+    comparison.
+
+    Each thread has its own table, or with WITH_SYMENGINE_INTERN_GLOBAL all
+    threads share one. The table does not own its entries, an instance is
+    removed from the table that stores it when its last reference goes away,
+    on whichever thread that happens.
+*/
+RCP<const Basic> intern(RCP<const Basic> x);
+//! \return the number of instances in the intern table used by this thread
+std::size_t intern_table_size();
+#else
+inline RCP<const Basic> intern(RCP<const Basic> x)
+{
+    return x;
+}
+#endif
+
 //! Expands `self`
 RCP<const Basic> expand(const RCP<const Basic> &self);
 void as_numer_denom(const RCP<const Basic> &x, const Ptr<RCP<const Basic>> &numer, const Ptr<RCP<const Basic>> &denom);
+
+/*! \return a hash of the `len` bytes at `p`, the same on all platforms with
+    the same `std::size_t`. On 64 bit platforms it is the value of
+    `std::hash<std::string>` of libstdc++. */
+std::size_t hash_bytes(const void *p, std::size_t len);
+
+/*! Hash of `v` used by `hash_combine()` and `__hash__()`. Unlike `std::hash`
+    it is the same on all platforms for strings, doubles and integers, so
+    the order of `RCPBasicKeyLess`, which compares hashes, is too. */
+template <class T>
+std::size_t stable_hash(const T& v);
+
 } // SymEngine
 
 /*! This `<<` overloaded function simply calls `p.__str__`, so it allows any Basic
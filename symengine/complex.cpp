@@ -31,10 +31,12 @@ std::size_t Complex::__hash__() const
     // only the least significant bits that fit into "signed long int" are
     // hashed:
     std::size_t seed = COMPLEX;
-    hash_combine<long long int>(seed, this->real_.get_num().get_si());
-    hash_combine<long long int>(seed, this->real_.get_den().get_si());
-    hash_combine<long long int>(seed, this->imaginary_.get_num().get_si());
-    hash_combine<long long int>(seed, this->imaginary_.get_den().get_si());
+    hash_combine<long long int>(seed, mpz_hash_bits(this->real_.get_num_mpz_t()));
+    hash_combine<long long int>(seed, mpz_hash_bits(this->real_.get_den_mpz_t()));
+    hash_combine<long long int>(seed,
+        mpz_hash_bits(this->imaginary_.get_num_mpz_t()));
+    hash_combine<long long int>(seed,
+        mpz_hash_bits(this->imaginary_.get_den_mpz_t()));
     return seed;
 }
 
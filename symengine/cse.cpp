@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
+
+#include <symengine/visitor.h>
+
+namespace SymEngine {
+
+typedef std::unordered_map<RCP<const Basic>, vec_basic,
+        RCPBasicHash, RCPBasicKeyEq> umap_basic_vec;
+typedef std::unordered_map<RCP<const Basic>, std::vector<unsigned>,
+        RCPBasicHash, RCPBasicKeyEq> umap_basic_vec_uint;
+typedef std::unordered_set<RCP<const Basic>,
+        RCPBasicHash, RCPBasicKeyEq> uset_basic;
+
+//! Numbers, symbols and constants are never replaced
+inline bool cse_is_atom(const Basic &b)
+{
+    return is_a_Number(b) or is_a<Symbol>(b) or is_a<Constant>(b);
+}
+
+/*
+   Finds arguments shared by at least two of the `funcs` (all of them either
+   Add or Mul) and rewrites both in terms of a new node holding the common
+   arguments, e.g. `x + y + z` and `x + y + w` become `(x + y) + z` and
+   `(x + y) + w`. The rewritten argument lists are stored in `opt_subs`.
+   This follows the algorithm of SymPy's `match_common_args`.
+*/
+static void match_common_args(vec_basic funcs, umap_basic_vec &opt_subs,
+        RCP<const Basic> (*build)(const vec_basic &))
+{
+    std::vector<set_basic> func_args;
+    std::vector<std::pair<std::size_t, unsigned>> order;
+    for (unsigned i = 0; i < funcs.size(); i++) {
+        vec_basic args = funcs[i]->get_args();
+        order.push_back(std::make_pair(args.size(), i));
+    }
+    // Process the nodes with fewer arguments first, the common arguments
+    // found between them are then reused by the larger ones.
+    std::sort(order.begin(), order.end());
+    vec_basic sorted;
+    for (const auto &p: order) sorted.push_back(funcs[p.second]);
+    funcs.swap(sorted);
+
+    umap_basic_vec_uint arg_to_funcs;
+    for (unsigned i = 0; i < funcs.size(); i++) {
+        vec_basic args = funcs[i]->get_args();
+        func_args.push_back(set_basic(args.begin(), args.end()));
+        for (const auto &a: args) arg_to_funcs[a].push_back(i);
+    }
+
+    auto rewrite = [&](unsigned k, const set_basic &common,
+            const RCP<const Basic> &com_func) {
+        set_basic args;
+        std::set_difference(func_args[k].begin(), func_args[k].end(),
+            common.begin(), common.end(), std::inserter(args, args.end()),
+            RCPBasicKeyLess());
+        args.insert(com_func);
+        func_args[k] = args;
+        opt_subs[funcs[k]] = vec_basic(args.begin(), args.end());
+        arg_to_funcs[com_func].push_back(k);
+    };
+
+    for (unsigned i = 0; i < funcs.size(); i++) {
+        // Number of arguments shared with each of the later nodes
+        std::map<unsigned, unsigned> counts;
+        for (const auto &a: func_args[i]) {
+            for (unsigned j: arg_to_funcs[a]) {
+                if (j > i) counts[j]++;
+            }
+        }
+        for (auto it = counts.begin(); it != counts.end(); ++it) {
+            if (it->second < 2) continue;
+            unsigned j = it->first;
+            set_basic common;
+            std::set_intersection(func_args[i].begin(), func_args[i].end(),
+                func_args[j].begin(), func_args[j].end(),
+                std::inserter(common, common.end()), RCPBasicKeyLess());
+            if (common.size() < 2) continue;
+
+            RCP<const Basic> com_func;
+            if (common.size() < func_args[i].size()) {
+                com_func = build(vec_basic(common.begin(), common.end()));
+                rewrite(i, common, com_func);
+            } else {
+                com_func = funcs[i];
+            }
+            rewrite(j, common, com_func);
+            // Any other candidate containing all the common arguments
+            // reuses the same node
+            for (auto it2 = std::next(it); it2 != counts.end(); ++it2) {
+                unsigned k = it2->first;
+                if (it2->second < 2) continue;
+                if (std::includes(func_args[k].begin(), func_args[k].end(),
+                        common.begin(), common.end(), RCPBasicKeyLess())) {
+                    rewrite(k, common, com_func);
+                }
+            }
+        }
+    }
+}
+
+class CSEHelper {
+protected:
+    umap_basic_vec opt_subs_;
+    uset_basic seen_, to_eliminate_;
+    umap_basic_basic subs_;
+    vec_pair &replacements_;
+    std::set<std::string> names_;
+    unsigned next_symbol_ = 0;
+
+    vec_basic args(const RCP<const Basic> &e) const {
+        auto it = opt_subs_.find(e);
+        if (it != opt_subs_.end()) return it->second;
+        return e->get_args();
+    }
+
+    RCP<const Basic> next_symbol() {
+        std::string name;
+        do {
+            name = "x" + std::to_string(next_symbol_++);
+        } while (names_.find(name) != names_.end());
+        return symbol(name);
+    }
+
+public:
+    CSEHelper(vec_pair &replacements) : replacements_(replacements) {}
+
+    void optimize(const vec_basic &exprs) {
+        // Collect all distinct Add and Mul nodes and the names in use
+        vec_basic adds, muls, stack(exprs.begin(), exprs.end());
+        uset_basic visited;
+        while (not stack.empty()) {
+            RCP<const Basic> e = stack.back();
+            stack.pop_back();
+            if (is_a<Symbol>(*e)) {
+                names_.insert(rcp_static_cast<const Symbol>(e)->get_name());
+            }
+            if (cse_is_atom(*e) or not visited.insert(e).second) continue;
+            if (is_a<Add>(*e)) {
+                adds.push_back(e);
+            } else if (is_a<Mul>(*e)) {
+                muls.push_back(e);
+            }
+            for (const auto &a: e->get_args()) stack.push_back(a);
+        }
+        match_common_args(adds, opt_subs_, add);
+        match_common_args(muls, opt_subs_, mul);
+    }
+
+    void find_repeated(const RCP<const Basic> &e) {
+        if (cse_is_atom(*e)) return;
+        if (not seen_.insert(e).second) {
+            to_eliminate_.insert(e);
+            return;
+        }
+        for (const auto &a: args(e)) find_repeated(a);
+    }
+
+    RCP<const Basic> rebuild(const RCP<const Basic> &e) {
+        if (cse_is_atom(*e)) return e;
+        auto it = subs_.find(e);
+        if (it != subs_.end()) return it->second;
+
+        vec_basic old_args = args(e), new_args;
+        for (const auto &a: old_args) new_args.push_back(rebuild(a));
+        RCP<const Basic> new_e;
+        if (is_a<Add>(*e)) {
+            new_e = add(new_args);
+        } else if (is_a<Mul>(*e)) {
+            new_e = mul(new_args);
+        } else if (is_a<Pow>(*e)) {
+            new_e = pow(new_args[0], new_args[1]);
+        } else {
+            map_basic_basic d;
+            for (unsigned i = 0; i < old_args.size(); i++) {
+                insert(d, old_args[i], new_args[i]);
+            }
+            new_e = e->subs(d);
+        }
+
+        if (to_eliminate_.find(e) != to_eliminate_.end()) {
+            RCP<const Basic> sym = next_symbol();
+            replacements_.push_back(std::make_pair(sym, new_e));
+            new_e = sym;
+        }
+        insert(subs_, e, new_e);
+        return new_e;
+    }
+};
+
+void cse(vec_pair &replacements, vec_basic &reduced_exprs,
+        const vec_basic &exprs)
+{
+    CSEHelper helper(replacements);
+    helper.optimize(exprs);
+    for (const auto &e: exprs) helper.find_repeated(e);
+    for (const auto &e: exprs) reduced_exprs.push_back(helper.rebuild(e));
+}
+
+} // SymEngine
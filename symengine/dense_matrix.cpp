@@ -1,8 +1,15 @@
+#include <algorithm>
+
 #include <symengine/matrix.h>
+#include <symengine/numeric_matrix.h>
 #include <symengine/add.h>
 #include <symengine/mul.h>
 #include <symengine/integer.h>
 #include <symengine/pow.h>
+#include <symengine/derivative.h>
+#include <symengine/rational.h>
+#include <symengine/real_double.h>
+#include <symengine/parallel.h>
 
 namespace SymEngine {
 
@@ -36,12 +43,49 @@ void DenseMatrix::set(unsigned i, unsigned j, const RCP<const Basic> &e)
 
 unsigned DenseMatrix::rank() const
 {
-    throw std::runtime_error("Not implemented.");
+    switch (numeric_domain(m_)) {
+        case NumericDomain::integer: {
+            IntegerDenseMatrix A;
+            to_numeric(m_, row_, col_, A);
+            return rank_numeric(A);
+        }
+        case NumericDomain::rational: {
+            RationalDenseMatrix A;
+            to_numeric(m_, row_, col_, A);
+            return rank_numeric(A);
+        }
+        case NumericDomain::real_double: {
+            DoubleDenseMatrix A;
+            to_numeric(m_, row_, col_, A);
+            return rank_numeric(A);
+        }
+        default:
+            throw std::runtime_error("Not implemented.");
+    }
 }
 
 RCP<const Basic> DenseMatrix::det() const
 {
-    return det_bareis(*this);
+    SYMENGINE_ASSERT(row_ == col_);
+    switch (numeric_domain(m_)) {
+        case NumericDomain::integer: {
+            IntegerDenseMatrix A;
+            to_numeric(m_, row_, col_, A);
+            return integer(det_numeric(A));
+        }
+        case NumericDomain::rational: {
+            RationalDenseMatrix A;
+            to_numeric(m_, row_, col_, A);
+            return Rational::from_mpq(det_numeric(A));
+        }
+        case NumericDomain::real_double: {
+            DoubleDenseMatrix A;
+            to_numeric(m_, row_, col_, A);
+            return real_double(det_numeric(A));
+        }
+        default:
+            return det_bareis(*this);
+    }
 }
 
 void DenseMatrix::inv(MatrixBase &result) const
@@ -172,19 +216,24 @@ void jacobian(const DenseMatrix &A, const DenseMatrix &x,
     SYMENGINE_ASSERT(A.col_ == 1);
     SYMENGINE_ASSERT(x.col_ == 1);
     SYMENGINE_ASSERT(A.row_ == result.nrows() and x.row_ == result.ncols());
+    // The rows share the cache, so common subexpressions of the system are
+    // differentiated once per symbol.
+    DiffCache cache;
     for (unsigned i = 0; i < result.row_; i++) {
-        for (unsigned j = 0; j < result.col_; j++) {
-            if (is_a<Symbol>(*(x.m_[j]))) {
-                const RCP<const Symbol> x_ = rcp_static_cast<const Symbol>(
-                        x.m_[j]);
-                result.m_[i*result.col_ + j] = A.m_[i]->diff(x_);
-            } else {
-                throw std::runtime_error("'x' must contain Symbols only");
-            }
-        }
+        vec_basic g = cache.gradient(A.m_[i], x.m_);
+        std::copy(g.begin(), g.end(), result.m_.begin() + i*result.col_);
     }
 }
 
+void hessian(const RCP<const Basic> &f, const DenseMatrix &x,
+        DenseMatrix &result)
+{
+    SYMENGINE_ASSERT(x.col_ == 1);
+    SYMENGINE_ASSERT(x.row_ == result.nrows() and x.row_ == result.ncols());
+    DiffCache cache;
+    result.m_ = cache.hessian(f, x.m_);
+}
+
 
 // ----------------------------- Matrix Transpose ----------------------------//
 void transpose_dense(const DenseMatrix &A, DenseMatrix &B)
@@ -243,23 +292,88 @@ void add_dense_scalar(const DenseMatrix &A, const RCP<const Basic> &k, DenseMatr
 }
 
 // ------------------------------- Matrix Multiplication ---------------------//
-void mul_dense_dense(const DenseMatrix &A, const DenseMatrix &B,
-        DenseMatrix &C)
+
+//! \return true if `x` is an exact zero, so that its products vanish
+static inline bool is_structural_zero(const RCP<const Basic> &x)
 {
-    SYMENGINE_ASSERT(A.col_ == B.row_ and C.row_ == A.row_ and C.col_ == B.col_);
+    return is_a_Number(*x) and rcp_static_cast<const Number>(x)->is_exact_zero();
+}
 
-    unsigned row = A.row_, col = B.col_;
+//! Adds the products `a[i]*b[i]` for `i` in `[0, n)` to `sum`, skipping the
+//! ones with an exact zero factor
+static void add_dot(AddBuilder &sum, const RCP<const Basic> *a,
+        const RCP<const Basic> *b, unsigned n)
+{
+    for (unsigned i = 0; i < n; i++) {
+        if (not is_structural_zero(a[i]) and not is_structural_zero(b[i]))
+            sum.add_term(mul(a[i], b[i]));
+    }
+}
 
-    for (unsigned r = 0; r<row; r++) {
-        for (unsigned c = 0; c<col; c++) {
-            C.m_[r*col + c] = zero; // Integer Zero
-            for (unsigned k = 0; k<A.col_; k++)
-                C.m_[r*col + c] = add(C.m_[r*col + c],
-                    mul(A.m_[r*A.col_ + k], B.m_[k*col + c]));
+//! Number of columns of `C` accumulated at once by `mul_dense_rows()`
+static const unsigned mul_tile = 32;
+
+/*! Computes the rows `[r0, r1)` of `C = A*B`. Every entry of `C` is summed in
+    one AddBuilder instead of a chain of `add()` calls, each of which would
+    copy the dictionary of the partial sum.
+
+    The loops run row of `A` by row of `B`, so that a zero of `A` skips a
+    whole row of `B`, over tiles of `mul_tile` columns of `C`, which bounds
+    the number of partial sums kept alive.
+*/
+static void mul_dense_rows(const RCP<const Basic> *A, const RCP<const Basic> *B,
+        RCP<const Basic> *C, unsigned n, unsigned col, unsigned r0, unsigned r1)
+{
+    std::vector<AddBuilder> sums(std::min(col, mul_tile));
+    for (unsigned r = r0; r < r1; r++) {
+        for (unsigned c0 = 0; c0 < col; c0 += mul_tile) {
+            unsigned c1 = std::min(col, c0 + mul_tile);
+            for (unsigned k = 0; k < n; k++) {
+                const RCP<const Basic> &a = A[r*n + k];
+                if (is_structural_zero(a))
+                    continue;
+                for (unsigned c = c0; c < c1; c++) {
+                    const RCP<const Basic> &b = B[k*col + c];
+                    if (not is_structural_zero(b))
+                        sums[c - c0].add_term(mul(a, b));
+                }
+            }
+            for (unsigned c = c0; c < c1; c++)
+                C[r*col + c] = sums[c - c0].finish();
         }
     }
 }
 
+#if defined(SYMENGINE_PARALLEL)
+//! Number of entry products below which multiplying in parallel does not pay
+static const std::size_t mul_split_threshold = 4096;
+#endif
+
+void mul_dense_dense(const DenseMatrix &A, const DenseMatrix &B,
+        DenseMatrix &C)
+{
+    SYMENGINE_ASSERT(A.col_ == B.row_ and C.row_ == A.row_ and C.col_ == B.col_);
+    SYMENGINE_ASSERT(&C != &A and &C != &B);
+
+    unsigned row = A.row_, col = B.col_, n = A.col_;
+    const RCP<const Basic> *a = A.m_.data(), *b = B.m_.data();
+    RCP<const Basic> *c = C.m_.data();
+
+#if defined(SYMENGINE_PARALLEL)
+    if (row > 1 and std::size_t(row) * col * n >= mul_split_threshold
+            and parallel_available()) {
+        // Rows of C are independent, and deal them out dynamically as their
+        // cost depends on the number of zeros and the size of the entries
+        parallel_for(row, ParallelSchedule::dynamic,
+            [&](std::size_t, std::size_t r) {
+                mul_dense_rows(a, b, c, n, col, r, r + 1);
+            });
+        return;
+    }
+#endif
+    mul_dense_rows(a, b, c, n, col, 0, row);
+}
+
 void mul_dense_scalar(const DenseMatrix &A, const RCP<const Basic> &k, DenseMatrix& B)
 {
     SYMENGINE_ASSERT(A.col_ == B.col_ and A.row_ == B.row_);
@@ -544,6 +658,54 @@ unsigned pivot(DenseMatrix &B, unsigned r, unsigned c)
 }
 
 // --------------------------- Solve Ax = b  ---------------------------------//
+
+/*! Solves `A*X = B` with the `n` by `n` entries `a` of `A` and the `n` by `k`
+    entries `b` of `B`, or the identity matrix for `B` if `b` is null, in the
+    numeric matrices of `T`. The solution has entries of type `S`.
+*/
+template <typename T, typename S>
+static bool solve_in(const vec_basic &a, const vec_basic *b, unsigned n,
+        unsigned k, vec_basic &x)
+{
+    NumericDenseMatrix<T> A, B;
+    NumericDenseMatrix<S> X;
+    to_numeric(a, n, n, A);
+    if (b) {
+        to_numeric(*b, n, k, B);
+    } else {
+        B = NumericDenseMatrix<T>(n, n);
+        for (unsigned i = 0; i < n; i++)
+            B(i, i) = 1;
+    }
+    if (not solve_numeric(A, B, X))
+        return false;
+    from_numeric(X, x);
+    return true;
+}
+
+/*! Solves `A*X = B` as `solve_in()` if all the entries are numbers, in the
+    numeric matrices of their domain.
+    \return false if some entry is not a number or `A` is singular, to leave
+    these systems to the symbolic algorithms
+*/
+static bool solve_numeric_dense(const vec_basic &a, const vec_basic *b,
+        unsigned n, unsigned k, vec_basic &x)
+{
+    NumericDomain d = numeric_domain(a);
+    if (b)
+        d = numeric_domain(d, numeric_domain(*b));
+    switch (d) {
+        case NumericDomain::integer:
+            return solve_in<mpz_class, mpq_class>(a, b, n, k, x);
+        case NumericDomain::rational:
+            return solve_in<mpq_class, mpq_class>(a, b, n, k, x);
+        case NumericDomain::real_double:
+            return solve_in<double, double>(a, b, n, k, x);
+        default:
+            return false;
+    }
+}
+
 // Assuming A is a diagonal square matrix
 void diagonal_solve(const DenseMatrix &A, const DenseMatrix &b, DenseMatrix &x)
 {
@@ -644,6 +806,9 @@ void fraction_free_gauss_jordan_solve(const DenseMatrix &A, const DenseMatrix &b
     SYMENGINE_ASSERT(x.col_ == b.col_);
 
     unsigned i, j, k, col = A.col_, bcol = b.col_;
+    if (solve_numeric_dense(A.m_, &b.m_, col, bcol, x.m_))
+        return;
+
     RCP<const Basic> d;
     DenseMatrix A_ = DenseMatrix(A.row_, A.col_, A.m_);
     DenseMatrix b_ = DenseMatrix(b.row_, b.col_, b.m_);
@@ -685,6 +850,10 @@ void fraction_free_gauss_jordan_solve(const DenseMatrix &A, const DenseMatrix &b
 void fraction_free_LU_solve(const DenseMatrix &A, const DenseMatrix &b,
     DenseMatrix &x)
 {
+    SYMENGINE_ASSERT(x.row_ == A.col_ and x.col_ == b.col_);
+    if (solve_numeric_dense(A.m_, &b.m_, A.row_, b.col_, x.m_))
+        return;
+
     DenseMatrix LU = DenseMatrix(A.nrows(), A.ncols());
     DenseMatrix x_ = DenseMatrix(b.nrows(), 1);
 
@@ -695,6 +864,10 @@ void fraction_free_LU_solve(const DenseMatrix &A, const DenseMatrix &b,
 
 void LU_solve(const DenseMatrix &A, const DenseMatrix &b, DenseMatrix &x)
 {
+    SYMENGINE_ASSERT(x.row_ == A.col_ and x.col_ == b.col_);
+    if (solve_numeric_dense(A.m_, &b.m_, A.row_, b.col_, x.m_))
+        return;
+
     DenseMatrix L = DenseMatrix(A.nrows(), A.ncols());
     DenseMatrix U = DenseMatrix(A.nrows(), A.ncols());
     DenseMatrix x_ = DenseMatrix(b.nrows(), 1);
@@ -1052,7 +1225,8 @@ void berkowitz(const DenseMatrix &A, std::vector<DenseMatrix> &polys)
     SYMENGINE_ASSERT(A.row_ == A.col_);
 
     unsigned col = A.col_;
-    unsigned i, k, l, m;
+    unsigned i, k, l;
+    AddBuilder sum;
 
     std::vector<DenseMatrix> items;
     std::vector<DenseMatrix> transforms;
@@ -1074,19 +1248,16 @@ void berkowitz(const DenseMatrix &A, std::vector<DenseMatrix> &polys)
         for (i = 0; i < n - 2; i++) {
             DenseMatrix B = DenseMatrix(k, 1);
             for (l = 0; l < k; l++) {
-                B.m_[l] = zero;
-                for (m = 0; m < k; m++)
-                    B.m_[l] = add(B.m_[l], mul(A.m_[l*col + m], items[i].m_[m]));
+                add_dot(sum, &A.m_[l*col], items[i].m_.data(), k);
+                B.m_[l] = sum.finish();
             }
             items.push_back(B);
         }
 
         items_.clear();
         for (i = 0; i < n - 1; i++) {
-            RCP<const Basic> element = zero;
-            for (l = 0; l < k; l++)
-                element = add(element, mul(A.m_[k*col + l], items[i].m_[l]));
-            items_.push_back(mul(minus_one, element));
+            add_dot(sum, &A.m_[k*col], items[i].m_.data(), k);
+            items_.push_back(mul(minus_one, sum.finish()));
         }
         items_.insert(items_.begin(), mul(minus_one, A.m_[k*col + k]));
         items_.insert(items_.begin(), one);
@@ -1107,12 +1278,9 @@ void berkowitz(const DenseMatrix &A, std::vector<DenseMatrix> &polys)
         DenseMatrix B = DenseMatrix(t_row, 1);
 
         for (l = 0; l < t_row; l++) {
-            B.m_[l] = zero;
-            for (m = 0; m < t_col; m++) {
-                B.m_[l] = add(B.m_[l],
-                    mul(transforms[col - 2 - i].m_[l*t_col + m], polys[i].m_[m]));
-                B.m_[l] = expand(B.m_[l]);
-            }
+            add_dot(sum, &transforms[col - 2 - i].m_[l*t_col],
+                polys[i].m_.data(), t_col);
+            B.m_[l] = expand(sum.finish());
         }
         polys.push_back(B);
     }
@@ -1147,6 +1315,9 @@ void inverse_fraction_free_LU(const DenseMatrix &A, DenseMatrix &B)
     SYMENGINE_ASSERT(A.row_ == A.col_ and B.row_ == B.col_ and B.row_ == A.row_);
 
     unsigned n = A.row_, i;
+    if (solve_numeric_dense(A.m_, nullptr, n, n, B.m_))
+        return;
+
     DenseMatrix LU = DenseMatrix(n, n);
     DenseMatrix e = DenseMatrix(n, 1);
     DenseMatrix x = DenseMatrix(n, 1);
@@ -1186,6 +1357,9 @@ void inverse_LU(const DenseMatrix &A, DenseMatrix&B)
     SYMENGINE_ASSERT(A.row_ == A.col_ and B.row_ == B.col_ and B.row_ == A.row_);
 
     unsigned n = A.row_, i;
+    if (solve_numeric_dense(A.m_, nullptr, n, n, B.m_))
+        return;
+
     DenseMatrix L = DenseMatrix(n, n);
     DenseMatrix U = DenseMatrix(n, n);
     DenseMatrix e = DenseMatrix(n, 1);
@@ -1228,6 +1402,9 @@ void inverse_gauss_jordan(const DenseMatrix &A, DenseMatrix &B)
     SYMENGINE_ASSERT(A.row_ == A.col_ and B.row_ == B.col_ and B.row_ == A.row_);
 
     unsigned n = A.row_;
+    if (solve_numeric_dense(A.m_, nullptr, n, n, B.m_))
+        return;
+
     DenseMatrix e = DenseMatrix(n, n);
 
     // Initialize matrices
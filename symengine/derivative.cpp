@@ -12,11 +12,38 @@
 #include <symengine/polynomial.h>
 #include <symengine/complex_double.h>
 #include <symengine/complex_mpc.h>
+#include <symengine/derivative.h>
 
 namespace SymEngine {
 
 extern RCP<const Basic> i2;
 
+// The cache used by Basic::diff() while DiffCache::diff() runs on the thread
+static thread_local DiffCache *current_diff_cache = nullptr;
+
+//! Makes a DiffCache current for the lifetime of the instance
+class DiffCacheScope {
+private:
+    DiffCache *prev_;
+public:
+    DiffCacheScope(DiffCache *cache) : prev_{current_diff_cache} {
+        current_diff_cache = cache;
+    }
+    ~DiffCacheScope() {
+        current_diff_cache = prev_;
+    }
+};
+
+//! \return true if the derivative of `b` can be nonzero even if it does not
+//! contain the symbol (the Derivative of these is never evaluated)
+static bool diff_is_opaque(const Basic &b)
+{
+    return is_a<KroneckerDelta>(b) or is_a<Dirichlet_eta>(b)
+        or is_a<UpperGamma>(b) or is_a<LowerGamma>(b) or is_a<Beta>(b)
+        or is_a<PolyGamma>(b) or is_a<LeviCivita>(b)
+        or is_a<UnivariateSeries>(b) or is_a<FunctionWrapper>(b);
+}
+
 class DiffImplementation {
 public:
 // Uncomment the following define in order to debug the methods:
@@ -422,11 +449,32 @@ static RCP<const Basic> diff(const CLASS &self, \
         return self.diff_impl(x);
     }
 
+    // Looks the derivative up in the current DiffCache, if there is one
+    template <class T>
+    static RCP<const Basic> diff_cached(const T &self,
+            const RCP<const Symbol> &x) {
+        DiffCache *cache = current_diff_cache;
+        if (cache == nullptr or is_a_Number(self) or is_a<Symbol>(self)
+                or is_a<Constant>(self))
+            return diff(self, x);
+        RCP<const Basic> b = self.rcp_from_this();
+        const DiffCache::NodeSymbols &s = cache->symbols(b);
+        if (not s.opaque and s.symbols.find(x) == s.symbols.end())
+            return zero;
+        // References to the elements stay valid while the maps grow
+        umap_basic_basic &d = cache->diffs_[x];
+        auto it = d.find(b);
+        if (it != d.end())
+            return it->second;
+        RCP<const Basic> r = diff(self, x);
+        insert(d, b, r);
+        return r;
+    }
 };
 
 #define IMPLEMENT_DIFF(CLASS) \
 RCP<const Basic> CLASS::diff(const RCP<const Symbol> &x) const { \
-    return DiffImplementation::diff(*this, x); \
+    return DiffImplementation::diff_cached(*this, x); \
 };
 
 
@@ -434,5 +482,71 @@ RCP<const Basic> CLASS::diff(const RCP<const Symbol> &x) const { \
 #include "symengine/type_codes.inc"
 #undef SYMENGINE_ENUM
 
+const DiffCache::NodeSymbols &DiffCache::symbols(const RCP<const Basic> &e)
+{
+    auto it = symbols_.find(e);
+    if (it != symbols_.end())
+        return it->second;
+    NodeSymbols s;
+    s.opaque = diff_is_opaque(*e);
+    auto merge = [&](const RCP<const Basic> &a) {
+        if (is_a_Number(*a)) return;
+        const NodeSymbols &t = symbols(a);
+        s.symbols.insert(t.symbols.begin(), t.symbols.end());
+        s.opaque = s.opaque or t.opaque;
+    };
+    if (is_a<Symbol>(*e)) {
+        s.symbols.insert(e);
+    } else if (is_a<Add>(*e)) {
+        // Add::get_args() would create the terms, only the keys matter
+        for (const auto &p: static_cast<const Add &>(*e).dict_)
+            merge(p.first);
+    } else if (is_a<Mul>(*e)) {
+        for (const auto &p: static_cast<const Mul &>(*e).dict_) {
+            merge(p.first);
+            merge(p.second);
+        }
+    } else {
+        if (is_a<UnivariatePolynomial>(*e))
+            s.symbols.insert(static_cast<const UnivariatePolynomial &>(*e)
+                .get_var());
+        for (const auto &a: e->get_args())
+            merge(a);
+    }
+    return symbols_.insert(std::make_pair(e, std::move(s))).first->second;
+}
+
+RCP<const Basic> DiffCache::diff(const RCP<const Basic> &e,
+        const RCP<const Symbol> &x)
+{
+    DiffCacheScope scope(this);
+    return e->diff(x);
+}
+
+vec_basic DiffCache::gradient(const RCP<const Basic> &e, const vec_basic &x)
+{
+    vec_basic g;
+    g.reserve(x.size());
+    for (const auto &s: x) {
+        if (not is_a<Symbol>(*s))
+            throw std::runtime_error("'x' must contain Symbols only");
+        g.push_back(diff(e, rcp_static_cast<const Symbol>(s)));
+    }
+    return g;
+}
+
+vec_basic DiffCache::hessian(const RCP<const Basic> &e, const vec_basic &x)
+{
+    const std::size_t n = x.size();
+    vec_basic g = gradient(e, x);
+    vec_basic h(n * n);
+    for (std::size_t i = 0; i < n; i++) {
+        for (std::size_t j = i; j < n; j++) {
+            h[i * n + j] = diff(g[i], rcp_static_cast<const Symbol>(x[j]));
+            h[j * n + i] = h[i * n + j];
+        }
+    }
+    return h;
+}
 
 } // SymEngine
@@ -0,0 +1,64 @@
+/**
+ *  \file derivative.h
+ *  Memoized differentiation of batches of expressions
+ *
+ **/
+#ifndef SYMENGINE_DERIVATIVE_H
+#define SYMENGINE_DERIVATIVE_H
+
+#include <symengine/basic.h>
+#include <symengine/dict.h>
+
+namespace SymEngine {
+
+class DiffImplementation;
+
+/*! Differentiates a batch of expressions, caching the derivative of every
+    subtree with respect to every symbol. Subtrees shared inside an
+    expression, between the expressions of the batch or between an
+    expression and its derivatives are differentiated only once per symbol,
+    and subtrees that do not contain a symbol are not traversed at all to
+    differentiate with respect to it. The results are the same as
+    `Basic::diff()`.
+
+        DiffCache c;
+        vec_basic g = c.gradient(f, {x, y, z});
+        RCP<const Basic> fxy = c.diff(g[0], y);  // reuses the work on g[0]
+
+    The cache lives as long as the instance, so it should be dropped once
+    the batch is done.
+*/
+class DiffCache {
+private:
+    //! The symbols a subtree depends on
+    struct NodeSymbols {
+        set_basic symbols;
+        //! The subtree has nodes whose derivative is not known to be zero
+        //! when they do not contain the symbol (e.g. FunctionWrapper)
+        bool opaque;
+    };
+    std::unordered_map<RCP<const Basic>, NodeSymbols,
+        RCPBasicHash, RCPBasicKeyEq> symbols_;
+    //! `diffs_[x][e]` is the derivative of `e` with respect to `x`
+    std::unordered_map<RCP<const Basic>, umap_basic_basic,
+        RCPBasicHash, RCPBasicKeyEq> diffs_;
+
+    const NodeSymbols &symbols(const RCP<const Basic> &e);
+    friend class DiffImplementation;
+public:
+    //! \return `d e / d x`
+    RCP<const Basic> diff(const RCP<const Basic> &e,
+            const RCP<const Symbol> &x);
+    //! \return the derivatives of `e` with respect to all the symbols `x`
+    vec_basic gradient(const RCP<const Basic> &e, const vec_basic &x);
+    /*! \return `n*n` elements in row major order, the second derivatives of
+        `e` with respect to all the `n` symbols in `x`. The gradient is
+        computed once and its entries are differentiated, filling the
+        symmetric half from the other.
+    */
+    vec_basic hessian(const RCP<const Basic> &e, const vec_basic &x);
+};
+
+} // SymEngine
+
+#endif
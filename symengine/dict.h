@@ -11,6 +11,8 @@
 #define __GMPXX_USE_CXX11 1
 #include <gmpxx.h>
 
+#include <symengine/flat_hash_map.h>
+
 namespace SymEngine {
 
 class Basic;
@@ -21,7 +23,7 @@ struct RCPBasicKeyEq;
 struct RCPBasicKeyLess;
 struct RCPIntegerKeyLess;
 
-typedef std::unordered_map<RCP<const Basic>, RCP<const Number>,
+typedef FlatHashMap<RCP<const Basic>, RCP<const Number>,
         RCPBasicHash, RCPBasicKeyEq> umap_basic_num;
 typedef std::unordered_map<short, RCP<const Basic>> umap_short_basic;
 typedef std::unordered_map<int, RCP<const Basic>> umap_int_basic;
@@ -30,6 +32,7 @@ typedef std::unordered_map<RCP<const Basic>, RCP<const Basic>,
 
 typedef std::vector<int> vec_int;
 typedef std::vector<RCP<const Basic>> vec_basic;
+typedef std::vector<std::pair<RCP<const Basic>, RCP<const Basic>>> vec_pair;
 typedef std::vector<RCP<const Integer>> vec_integer;
 typedef std::set<RCP<const Basic>, RCPBasicKeyLess> set_basic;
 typedef std::multiset<RCP<const Basic>, RCPBasicKeyLess> multiset_basic;
@@ -56,20 +56,21 @@ public:
     }
 
     void bvisit(const Add &x) {
-        arb_t t;
+        arb_t t, c;
         arb_init(t);
-
-        auto d = x.get_args();
-        for (auto p = d.begin(); p != d.end();  p++) {
-
-            if (p == d.begin()) {
-                apply(result_, *(*p));
-            } else {
-                apply(t, *(*p));
-                arb_add(result_, result_, t, prec_);
+        arb_init(c);
+
+        apply(result_, *x.coef_);
+        for (const auto &p: x.dict_) {
+            apply(t, *p.first);
+            if (not p.second->is_one()) {
+                apply(c, *p.second);
+                arb_mul(t, t, c, prec_);
             }
+            arb_add(result_, result_, t, prec_);
         }
 
+        arb_clear(c);
         arb_clear(t);
     }
 
@@ -77,31 +78,33 @@ public:
         arb_t t;
         arb_init(t);
 
-        auto d = x.get_args();
-        for (auto p = d.begin(); p != d.end(); p++) {
-
-            if (p == d.begin()) {
-                apply(result_, *(*p));
-            } else {
-                apply(t, *(*p));
-                arb_mul(result_, result_, t, prec_);
-            }
+        apply(result_, *x.coef_);
+        for (const auto &p: x.dict_) {
+            pow(t, *p.first, *p.second);
+            arb_mul(result_, result_, t, prec_);
         }
 
         arb_clear(t);
     }
 
     void bvisit(const Pow &x) {
-        if (eq(*x.get_base(), *E)) {
-            apply(result_, *(x.get_exp()));
-            arb_exp(result_, result_, prec_);
+        pow(result_, *x.get_base(), *x.get_exp());
+    }
+
+    //! Sets `result = base**exp`, of a Pow or a factor of a Mul
+    void pow(arb_ptr result, const Basic &base, const Basic &exp) {
+        if (is_a_Number(exp) and static_cast<const Number &>(exp).is_one()) {
+            apply(result, base);
+        } else if (eq(base, *E)) {
+            apply(result, exp);
+            arb_exp(result, result, prec_);
         } else {
             arb_t b;
             arb_init(b);
 
-            apply(b, *(x.get_base()));
-            apply(result_, *(x.get_exp()));
-            arb_pow(result_, b, result_, prec_);
+            apply(b, base);
+            apply(result, exp);
+            arb_pow(result, b, result, prec_);
 
             arb_clear(b);
         }
@@ -55,26 +55,32 @@ public:
         result_ = tmp;
     }
 #endif
+    // Add and Mul are evaluated from their coefficient and dictionary,
+    // get_args() would create a Mul or Pow for every term
     void bvisit(const Add &x) {
-        T tmp = 0;
-        for (const auto &p: x.get_args()) tmp += apply(*p);
+        T tmp = apply(*x.coef_);
+        for (const auto &p: x.dict_) tmp += apply(*p.second) * apply(*p.first);
         result_ = tmp;
     }
 
     void bvisit(const Mul &x) {
-        T tmp = 1;
-        for (const auto &p: x.get_args()) tmp *= apply(*p);
+        T tmp = apply(*x.coef_);
+        for (const auto &p: x.dict_) tmp *= pow(*p.first, *p.second);
         result_ = tmp;
     }
 
     void bvisit(const Pow &x) {
-        T exp_ = apply(*(x.get_exp()));
-        if (eq(*(x.get_base()), *E)) {
-            result_ = std::exp(exp_);
-        } else {
-            T base_ = apply(*(x.get_base()));
-            result_ = std::pow(base_, exp_);
-        }
+        result_ = pow(*x.get_base(), *x.get_exp());
+    }
+
+    //! \return `base**exp`, of a Pow or a factor of a Mul
+    T pow(const Basic &base, const Basic &exp) {
+        if (is_a_Number(exp) and static_cast<const Number &>(exp).is_one())
+            return apply(base);
+        T exp_ = apply(exp);
+        if (eq(base, *E)) return std::exp(exp_);
+        T base_ = apply(base);
+        return std::pow(base_, exp_);
     }
 
     void bvisit(const Sin &x) {
@@ -253,7 +259,7 @@ public:
     };
 
     void bvisit(const Gamma &x) {
-        double tmp = apply(*(x.get_args()[0]));
+        double tmp = apply(*(x.get_arg()));
         result_ = std::tgamma(tmp);
     };
 };
@@ -314,13 +320,15 @@ std::vector<fn> init_eval_double()
         return tmp;
     };
     table[ADD] = [](const Basic &x) {
-        double tmp = 0;
-        for (const auto &p: x.get_args()) tmp += eval_double_single_dispatch(*p);
+        const Add &a = static_cast<const Add &>(x);
+        double tmp = eval_double_single_dispatch(*a.coef_);
+        for (const auto &p: a.dict_) tmp += eval_double_single_dispatch(*p.second) * eval_double_single_dispatch(*p.first);
         return tmp;
     };
     table[MUL] = [](const Basic &x) {
-        double tmp = 1;
-        for (const auto &p: x.get_args()) tmp *= eval_double_single_dispatch(*p);
+        const Mul &m = static_cast<const Mul &>(x);
+        double tmp = eval_double_single_dispatch(*m.coef_);
+        for (const auto &p: m.dict_) tmp *= ::pow(eval_double_single_dispatch(*p.first), eval_double_single_dispatch(*p.second));
         return tmp;
     };
     table[POW] = [](const Basic &x) {
@@ -438,7 +446,7 @@ std::vector<fn> init_eval_double()
         return ::acosh(1/tmp);
     };
     table[GAMMA] = [](const Basic &x) {
-        double tmp = eval_double_single_dispatch(*(static_cast<const Gamma &>(x)).get_args()[0]);
+        double tmp = eval_double_single_dispatch(*(static_cast<const Gamma &>(x)).get_arg());
         return ::tgamma(tmp);
     };
     table[CONSTANT] = [](const Basic &x) {
@@ -58,17 +58,20 @@ public:
     }
 
     void bvisit(const Add &x) {
-        mpc_t t;
+        mpc_t t, c;
         mpc_init2(t, mpc_get_prec(result_));
-
-        auto d = x.get_args();
-        auto p = d.begin();
-        apply(result_, *(*p));
-        p++;
-        for (; p != d.end();  p++) {
-            apply(t, *(*p));
+        mpc_init2(c, mpc_get_prec(result_));
+
+        apply(result_, *x.coef_);
+        for (const auto &p: x.dict_) {
+            apply(t, *p.first);
+            if (not p.second->is_one()) {
+                apply(c, *p.second);
+                mpc_mul(t, t, c, rnd_);
+            }
             mpc_add(result_, result_, t, rnd_);
         }
+        mpc_clear(c);
         mpc_clear(t);
     }
 
@@ -76,28 +79,32 @@ public:
         mpc_t t;
         mpc_init2(t, mpc_get_prec(result_));
 
-        auto d = x.get_args();
-        auto p = d.begin();
-        apply(result_, *(*p));
-        p++;
-        for (; p != d.end();  p++) {
-            apply(t, *(*p));
+        apply(result_, *x.coef_);
+        for (const auto &p: x.dict_) {
+            pow(t, *p.first, *p.second);
             mpc_mul(result_, result_, t, rnd_);
         }
         mpc_clear(t);
     }
 
     void bvisit(const Pow &x) {
-        if (eq(*x.get_base(), *E)) {
-            apply(result_, *(x.get_exp()));
-            mpc_exp(result_, result_, rnd_);
+        pow(result_, *x.get_base(), *x.get_exp());
+    }
+
+    //! Sets `result = base**exp`, of a Pow or a factor of a Mul
+    void pow(mpc_ptr result, const Basic &base, const Basic &exp) {
+        if (is_a_Number(exp) and static_cast<const Number &>(exp).is_one()) {
+            apply(result, base);
+        } else if (eq(base, *E)) {
+            apply(result, exp);
+            mpc_exp(result, result, rnd_);
         } else {
             mpc_t t;
-            mpc_init2(t, mpc_get_prec(result_));
+            mpc_init2(t, mpc_get_prec(result));
 
-            apply(t, *(x.get_base()));
-            apply(result_, *(x.get_exp()));
-            mpc_pow(result_, t, result_, rnd_);
+            apply(t, base);
+            apply(result, exp);
+            mpc_pow(result, t, result, rnd_);
 
             mpc_clear(t);
         }
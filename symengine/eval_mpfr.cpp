@@ -46,38 +46,43 @@ public:
     }
 
     void bvisit(const Add &x) {
-        mpfr_class t(mpfr_get_prec(result_));
-        auto d = x.get_args();
-        auto p = d.begin();
-        apply(result_, *(*p));
-        p++;
-        for (; p != d.end();  p++) {
-            apply(t.get_mpfr_t(), *(*p));
+        mpfr_class t(mpfr_get_prec(result_)), c(mpfr_get_prec(result_));
+        apply(result_, *x.coef_);
+        for (const auto &p: x.dict_) {
+            apply(t.get_mpfr_t(), *p.first);
+            if (not p.second->is_one()) {
+                apply(c.get_mpfr_t(), *p.second);
+                mpfr_mul(t.get_mpfr_t(), t.get_mpfr_t(), c.get_mpfr_t(), rnd_);
+            }
             mpfr_add(result_, result_, t.get_mpfr_t(), rnd_);
         }
     }
 
     void bvisit(const Mul &x) {
         mpfr_class t(mpfr_get_prec(result_));
-        auto d = x.get_args();
-        auto p = d.begin();
-        apply(result_, *(*p));
-        p++;
-        for (; p != d.end();  p++) {
-            apply(t.get_mpfr_t(), *(*p));
+        apply(result_, *x.coef_);
+        for (const auto &p: x.dict_) {
+            pow(t.get_mpfr_t(), *p.first, *p.second);
             mpfr_mul(result_, result_, t.get_mpfr_t(), rnd_);
         }
     }
 
     void bvisit(const Pow &x) {
-        if (eq(*x.get_base(), *E)) {
-            apply(result_, *(x.get_exp()));
-            mpfr_exp(result_, result_, rnd_);
+        pow(result_, *x.get_base(), *x.get_exp());
+    }
+
+    //! Sets `result = base**exp`, of a Pow or a factor of a Mul
+    void pow(mpfr_ptr result, const Basic &base, const Basic &exp) {
+        if (is_a_Number(exp) and static_cast<const Number &>(exp).is_one()) {
+            apply(result, base);
+        } else if (eq(base, *E)) {
+            apply(result, exp);
+            mpfr_exp(result, result, rnd_);
         } else {
-            mpfr_class b(mpfr_get_prec(result_));
-            apply(b.get_mpfr_t(), *(x.get_base()));
-            apply(result_, *(x.get_exp()));
-            mpfr_pow(result_, b.get_mpfr_t(), result_, rnd_);
+            mpfr_class b(mpfr_get_prec(result));
+            apply(b.get_mpfr_t(), base);
+            apply(result, exp);
+            mpfr_pow(result, b.get_mpfr_t(), result, rnd_);
         }
     }
 
@@ -220,7 +225,7 @@ public:
     };
 
     void bvisit(const Gamma &x) {
-        apply(result_, *(x.get_args()[0]));
+        apply(result_, *(x.get_arg()));
         mpfr_gamma(result_, result_, rnd_);
     };
 
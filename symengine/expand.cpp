@@ -1,6 +1,11 @@
 #include <symengine/basic.h>
 #include <symengine/visitor.h>
 #include <symengine/pow.h>
+#include <symengine/parallel.h>
+
+#if defined(WITH_SYMENGINE_PARALLEL_EXPAND) and defined(SYMENGINE_PARALLEL)
+#    define SYMENGINE_SPLIT_EXPAND
+#endif
 
 namespace SymEngine {
 
@@ -19,6 +24,36 @@ private:
     umap_basic_num d_;
     RCP<const Number> coeff = zero;
     RCP<const Number> multiply = one;
+
+#if defined(SYMENGINE_SPLIT_EXPAND)
+    //! Number of term products below which expanding in parallel does not pay
+    static const std::size_t split_threshold = 4096;
+
+    //! \return true if `work` term products are spread over the threads
+    static bool split_worthwhile(std::size_t work) {
+        return work >= split_threshold and parallel_available();
+    }
+
+    /*! Calls `f(v, i)` for all `i` in `[0, n)` from the OpenMP threads. Every
+        thread accumulates its terms in its own visitor `v` and the visitors
+        are merged into this one afterwards. Items are dealt round robin and
+        merged in thread order, so the result does not depend on the timing.
+    */
+    template <typename F>
+    void split(std::size_t n, F f) {
+        std::vector<ExpandVisitor> parts(parallel_threads());
+        for (auto &v: parts)
+            v.multiply = multiply;
+        parallel_for(n, ParallelSchedule::round_robin,
+            [&](std::size_t t, std::size_t i) { f(parts[t], i); });
+        for (auto &v: parts) {
+            iaddnum(outArg(coeff), v.coeff);
+            for (auto &p: v.d_)
+                Add::dict_add_term(d_, p.second, p.first);
+        }
+    }
+#endif
+
 public:
     RCP<const Basic> apply(const Basic &b) {
         b.accept(*this);
@@ -62,36 +97,24 @@ public:
         if (is_a<Add>(*a) && is_a<Add>(*b)) {
             iaddnum(outArg(coeff), _mulnum(multiply, _mulnum(rcp_static_cast<const Add>(a)->coef_,
                                                            rcp_static_cast<const Add>(b)->coef_)));
-            // Improves (x+1)**3*(x+2)**3*...(x+350)**3 expansion from 0.97s to 0.93s:
-#if defined(HAVE_SYMENGINE_RESERVE)
-            d_.reserve(d_.size() + (rcp_static_cast<const Add>(a))->dict_.size() *
-                                   (rcp_static_cast<const Add>(b))->dict_.size());
-#endif
+            // No room is reserved for the product of the sizes, it is only a
+            // bound (expand2 gives 6272 terms out of 666672 products) and the
+            // table would stay that large in the resulting Add.
             // Expand dicts first:
+            const Add &b_add = static_cast<const Add &>(*b);
+#if defined(SYMENGINE_SPLIT_EXPAND)
+            if (split_worthwhile((rcp_static_cast<const Add>(a))->dict_.size()
+                                 * b_add.dict_.size())) {
+                std::vector<std::pair<RCP<const Basic>, RCP<const Number>>>
+                    terms((rcp_static_cast<const Add>(a))->dict_.begin(),
+                          (rcp_static_cast<const Add>(a))->dict_.end());
+                split(terms.size(), [&](ExpandVisitor &v, std::size_t i) {
+                    v.mul_expand_term(terms[i].first, terms[i].second, b_add);
+                });
+            } else
+#endif
             for (auto &p: (rcp_static_cast<const Add>(a))->dict_) {
-                RCP<const Number> temp = _mulnum(p.second, multiply);
-                for (auto &q: (rcp_static_cast<const Add>(b))->dict_) {
-                    // The main bottleneck here is the mul(p.first, q.first) command
-                    RCP<const Basic> term = mul(p.first, q.first);
-                    if (is_a_Number(*term)) {
-                        iaddnum(outArg(coeff),
-                                _mulnum(_mulnum(temp, q.second), rcp_static_cast<const Number>(term)));
-                    } else {
-                        if (is_a<Mul>(*term) &&
-                            !(rcp_static_cast<const Mul>(term)->coef_->is_one())) {
-                            // Tidy up things like {2x: 3} -> {x: 6}
-                            RCP<const Number> coef2 =
-                                    rcp_static_cast<const Mul>(term)->coef_;
-                            // We make a copy of the dict_:
-                            map_basic_basic d2 = rcp_static_cast<const Mul>(term)->dict_;
-                            term = Mul::from_dict(one, std::move(d2));
-                            Add::dict_add_term(d_, _mulnum(_mulnum(temp, q.second), coef2), term);
-                        } else {
-                            Add::dict_add_term(d_, _mulnum(temp, q.second), term);
-                        }
-                    }
-                }
-                Add::dict_add_term(d_, _mulnum(rcp_static_cast<const Add>(b)->coef_, temp), p.first);
+                mul_expand_term(p.first, p.second, b_add);
             }
             // Handle the coefficient of "a":
             RCP<const Number> temp = _mulnum(rcp_static_cast<const Add>(a)->coef_, multiply);
@@ -144,21 +167,65 @@ public:
         _coef_dict_add_term(multiply, mul(a, b));
     }
 
+    //! Adds `t * c * b`, where `b` is expanded
+    void mul_expand_term(const RCP<const Basic> &t, const RCP<const Number> &c,
+                         const Add &b) {
+        RCP<const Number> temp = _mulnum(c, multiply);
+        for (auto &q: b.dict_) {
+            // The main bottleneck here is the mul(t, q.first) command
+            RCP<const Basic> term = mul(t, q.first);
+            if (is_a_Number(*term)) {
+                iaddnum(outArg(coeff),
+                        _mulnum(_mulnum(temp, q.second), rcp_static_cast<const Number>(term)));
+            } else {
+                if (is_a<Mul>(*term) &&
+                    !(rcp_static_cast<const Mul>(term)->coef_->is_one())) {
+                    // Tidy up things like {2x: 3} -> {x: 6}
+                    RCP<const Number> coef2 =
+                            rcp_static_cast<const Mul>(term)->coef_;
+                    // We make a copy of the dict_:
+                    map_basic_basic d2 = rcp_static_cast<const Mul>(term)->dict_;
+                    term = Mul::from_dict(one, std::move(d2));
+                    Add::dict_add_term(d_, _mulnum(_mulnum(temp, q.second), coef2), term);
+                } else {
+                    Add::dict_add_term(d_, _mulnum(temp, q.second), term);
+                }
+            }
+        }
+        Add::dict_add_term(d_, _mulnum(b.coef_, temp), t);
+    }
+
     void square_expand(umap_basic_num &base_dict) {
         long m = base_dict.size();
 #if defined(HAVE_SYMENGINE_RESERVE)
         d_.reserve(d_.size() + m * (m + 1) / 2);
 #endif
-        RCP<const Basic> t;
-        RCP<const Number> coef, two = integer(2);
-        for (auto p = base_dict.begin(); p != base_dict.end(); ++p) {
-            for (auto q = p; q != base_dict.end(); ++q) {
-                if (q == p) {
-                    _coef_dict_add_term(_mulnum(pownum((*p).second, two), multiply), pow((*p).first, two));
-                } else {
-                    _coef_dict_add_term(_mulnum(multiply, _mulnum((*p).second, _mulnum((*q).second, two))),
-                        mul((*q).first, (*p).first));
-                }
+#if defined(SYMENGINE_SPLIT_EXPAND)
+        if (split_worthwhile(m * (m + 1) / 2)) {
+            std::vector<umap_basic_num::const_iterator> rows;
+            rows.reserve(m);
+            for (auto p = base_dict.cbegin(); p != base_dict.cend(); ++p)
+                rows.push_back(p);
+            split(rows.size(), [&](ExpandVisitor &v, std::size_t i) {
+                v.square_expand_row(rows[i], base_dict.cend());
+            });
+            return;
+        }
+#endif
+        for (auto p = base_dict.cbegin(); p != base_dict.cend(); ++p)
+            square_expand_row(p, base_dict.cend());
+    }
+
+    //! Adds the products of the term `p` with itself and the terms after it
+    void square_expand_row(umap_basic_num::const_iterator p,
+                           umap_basic_num::const_iterator end) {
+        RCP<const Number> two = integer(2);
+        for (auto q = p; q != end; ++q) {
+            if (q == p) {
+                _coef_dict_add_term(_mulnum(pownum((*p).second, two), multiply), pow((*p).first, two));
+            } else {
+                _coef_dict_add_term(_mulnum(multiply, _mulnum((*p).second, _mulnum((*q).second, two))),
+                    mul((*q).first, (*p).first));
             }
         }
     }
@@ -173,67 +240,86 @@ public:
         // (y + x + z + w)**60 it improves the timing from 135ms to 124ms.
 #if defined(HAVE_SYMENGINE_RESERVE)
         d_.reserve(d_.size() + 2 * r.size());
+#endif
+#if defined(SYMENGINE_SPLIT_EXPAND)
+        if (split_worthwhile(r.size() * m)) {
+            std::vector<const map_vec_mpz::value_type *> terms;
+            terms.reserve(r.size());
+            for (auto &p: r)
+                terms.push_back(&p);
+            split(terms.size(), [&](ExpandVisitor &v, std::size_t i) {
+                v.pow_expand_term(base_dict, terms[i]->first, terms[i]->second);
+            });
+            return;
+        }
 #endif
         for (auto &p: r) {
-            auto power = p.first.begin();
-            auto i2 = base_dict.begin();
-            map_basic_basic d;
-            RCP<const Number> overall_coeff = one;
-            for (; power != p.first.end(); ++power, ++i2) {
-                if (*power > 0) {
-                    RCP<const Integer> exp = integer(std::move(*power));
-                    RCP<const Basic> base = i2->first;
-                    if (is_a<Integer>(*base)) {
-                        _imulnum(outArg(overall_coeff),
-                                rcp_static_cast<const Number>(
-                                        rcp_static_cast<const Integer>(base)->powint(*exp)));
-                    } else if (is_a<Symbol>(*base)) {
-                        Mul::dict_add_term(d, exp, base);
-                    } else {
-                        RCP<const Basic> exp2, t, tmp;
-                        tmp = pow(base, exp);
-                        if (is_a<Mul>(*tmp)) {
-                            for (auto &p: (rcp_static_cast<const Mul>(tmp))->dict_) {
-                                Mul::dict_add_term_new(outArg(overall_coeff), d,
-                                                       p.second, p.first);
-                            }
-                            _imulnum(outArg(overall_coeff), (rcp_static_cast<const Mul>(tmp))->coef_);
-                        } else if (is_a_Number(*tmp)) {
-                            _imulnum(outArg(overall_coeff), rcp_static_cast<const Number>(tmp));
-                        } else {
-                            Mul::as_base_exp(tmp, outArg(exp2), outArg(t));
-                            Mul::dict_add_term_new(outArg(overall_coeff), d, exp2, t);
+            pow_expand_term(base_dict, p.first, p.second);
+        }
+    }
+
+    //! Adds the multinomial term `c * prod(base_i**powers_i)`
+    void pow_expand_term(const umap_basic_num &base_dict, const vec_int &powers,
+                         const mpz_class &c)
+    {
+        auto power = powers.begin();
+        auto i2 = base_dict.begin();
+        map_basic_basic d;
+        RCP<const Number> overall_coeff = one;
+        for (; power != powers.end(); ++power, ++i2) {
+            if (*power > 0) {
+                RCP<const Integer> exp = integer(*power);
+                RCP<const Basic> base = i2->first;
+                if (is_a<Integer>(*base)) {
+                    _imulnum(outArg(overall_coeff),
+                            rcp_static_cast<const Number>(
+                                    rcp_static_cast<const Integer>(base)->powint(*exp)));
+                } else if (is_a<Symbol>(*base)) {
+                    Mul::dict_add_term(d, exp, base);
+                } else {
+                    RCP<const Basic> exp2, t, tmp;
+                    tmp = pow(base, exp);
+                    if (is_a<Mul>(*tmp)) {
+                        for (auto &p: (rcp_static_cast<const Mul>(tmp))->dict_) {
+                            Mul::dict_add_term_new(outArg(overall_coeff), d,
+                                                   p.second, p.first);
                         }
+                        _imulnum(outArg(overall_coeff), (rcp_static_cast<const Mul>(tmp))->coef_);
+                    } else if (is_a_Number(*tmp)) {
+                        _imulnum(outArg(overall_coeff), rcp_static_cast<const Number>(tmp));
+                    } else {
+                        Mul::as_base_exp(tmp, outArg(exp2), outArg(t));
+                        Mul::dict_add_term_new(outArg(overall_coeff), d, exp2, t);
                     }
-                    if (!(i2->second->is_one())) {
-                        if (is_a<Integer>(*(i2->second)) || is_a<Rational>(*(i2->second))) {
-                            _imulnum(outArg(overall_coeff),
-                                    pownum(i2->second,
-                                           rcp_static_cast<const Number>(exp)));
-                        } else if (is_a<Complex>(*(i2->second))) {
-                            RCP<const Number> tmp = rcp_static_cast<const Complex>(i2->second)->pow(*exp);
-                            _imulnum(outArg(overall_coeff), tmp);
-                        }
+                }
+                if (!(i2->second->is_one())) {
+                    if (is_a<Integer>(*(i2->second)) || is_a<Rational>(*(i2->second))) {
+                        _imulnum(outArg(overall_coeff),
+                                pownum(i2->second,
+                                       rcp_static_cast<const Number>(exp)));
+                    } else if (is_a<Complex>(*(i2->second))) {
+                        RCP<const Number> tmp = rcp_static_cast<const Complex>(i2->second)->pow(*exp);
+                        _imulnum(outArg(overall_coeff), tmp);
                     }
                 }
             }
-            RCP<const Basic> term = Mul::from_dict(overall_coeff, std::move(d));
-            RCP<const Number> coef2 = integer(p.second);
-            if (is_a_Number(*term)) {
-                iaddnum(outArg(coeff),
-                        _mulnum(_mulnum(multiply, rcp_static_cast<const Number>(term)), coef2));
-            } else {
-                if (is_a<Mul>(*term) &&
-                    !(rcp_static_cast<const Mul>(term)->coef_->is_one())) {
-                    // Tidy up things like {2x: 3} -> {x: 6}
-                    _imulnum(outArg(coef2),
-                            rcp_static_cast<const Mul>(term)->coef_);
-                    // We make a copy of the dict_:
-                    map_basic_basic d2 = rcp_static_cast<const Mul>(term)->dict_;
-                    term = Mul::from_dict(one, std::move(d2));
-                }
-                Add::dict_add_term(d_, _mulnum(multiply, coef2), term);
+        }
+        RCP<const Basic> term = Mul::from_dict(overall_coeff, std::move(d));
+        RCP<const Number> coef2 = integer(c);
+        if (is_a_Number(*term)) {
+            iaddnum(outArg(coeff),
+                    _mulnum(_mulnum(multiply, rcp_static_cast<const Number>(term)), coef2));
+        } else {
+            if (is_a<Mul>(*term) &&
+                !(rcp_static_cast<const Mul>(term)->coef_->is_one())) {
+                // Tidy up things like {2x: 3} -> {x: 6}
+                _imulnum(outArg(coef2),
+                        rcp_static_cast<const Mul>(term)->coef_);
+                // We make a copy of the dict_:
+                map_basic_basic d2 = rcp_static_cast<const Mul>(term)->dict_;
+                term = Mul::from_dict(one, std::move(d2));
             }
+            Add::dict_add_term(d_, _mulnum(multiply, coef2), term);
         }
     }
 
@@ -72,7 +72,13 @@ public:
     //! Overload addition and assignment(+=)
     Expression &operator+=(const Expression &other)
     {
-        m_basic = add(m_basic, other.m_basic);
+        // `other` may be `*this`, so its value is taken before `m_basic` is
+        // moved into the builder, which reuses the dictionary of `m_basic`
+        // if nobody else references it.
+        RCP<const Basic> t = other.m_basic;
+        AddBuilder b(std::move(m_basic));
+        b.add_term(t);
+        m_basic = b.finish();
         return *this;
     }
     //! Overload subtraction
@@ -90,7 +96,10 @@ public:
     //! Overload subtraction and assignment(-=)
     Expression &operator-=(const Expression &other)
     {
-        m_basic = sub(m_basic, other.m_basic);
+        RCP<const Basic> t = mul(minus_one, other.m_basic);
+        AddBuilder b(std::move(m_basic));
+        b.add_term(t);
+        m_basic = b.finish();
         return *this;
     }
     //! Overload multiplication
@@ -101,7 +110,11 @@ public:
     //! Overload multiplication and assignment (*=)
     Expression &operator*=(const Expression &other)
     {
-        m_basic = mul(m_basic, other.m_basic);
+        // See operator+=()
+        RCP<const Basic> t = other.m_basic;
+        MulBuilder b(std::move(m_basic));
+        b.mul_term(t);
+        m_basic = b.finish();
         return *this;
     }
     //! Overload Division
@@ -0,0 +1,309 @@
+/**
+ *  \file flat_hash_map.h
+ *  Open addressing hash map
+ *
+ **/
+#ifndef SYMENGINE_FLAT_HASH_MAP_H
+#define SYMENGINE_FLAT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace SymEngine {
+
+/*! Hash map storing its entries contiguously, in insertion order, with an
+    open addressing (linear probing) index on top of them.
+
+    Every entry holds the hash of its key and every index slot 32 bits of
+    it, so a lookup scans consecutive index slots and only calls `KeyEqual`
+    (which dereferences the keys) on a hash match, and growing rebuilds the
+    index without calling `Hash` or moving the entries. Compared to
+    `std::unordered_map` there is no heap node per entry and iterating is a
+    linear scan of the entries.
+
+    The interface is the subset of `std::unordered_map` used in SymEngine,
+    with these differences:
+
+    * Inserting may move the entries, so it invalidates iterators and
+      references.
+    * Erasing moves the last entry into the place of the erased one, so it
+      invalidates iterators and references to both, and `erase(it)` returns
+      nothing.
+    * The key of `value_type` is not const, so that entries can be moved;
+      it must not be modified through an iterator.
+    * There can be at most `2**32 - 1` entries.
+*/
+template<class Key, class T, class Hash, class KeyEqual>
+class FlatHashMap {
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<Key, T> value_type;
+    typedef std::size_t size_type;
+
+private:
+    struct Entry {
+        std::size_t hash;
+        value_type kv;
+        template<class V>
+        Entry(std::size_t h, V &&v) : hash{h}, kv(std::forward<V>(v)) {}
+    };
+    struct Slot {
+        //! The low bits of the hash of the entry
+        std::uint32_t hash;
+        //! The position of the entry, `none` for an empty slot
+        std::uint32_t entry;
+    };
+    static const std::uint32_t none = 0xFFFFFFFF;
+    static const std::size_t min_capacity = 8;
+
+    std::vector<Entry> entries_;
+    std::vector<Slot> index_;
+    //! Shift selecting the top bits of the multiplied hash as home slot
+    unsigned shift_;
+
+    //! Fibonacci hashing, so that hashes differing only in their high bits
+    //! do not collide
+    std::size_t home(std::size_t h) const {
+        return static_cast<std::size_t>(
+            (static_cast<std::uint64_t>(h) * UINT64_C(0x9E3779B97F4A7C15))
+                >> shift_);
+    }
+
+    std::size_t next(std::size_t i) const {
+        return (i + 1) & (index_.size() - 1);
+    }
+
+    //! \return the index size needed for `n` entries at a load of at most
+    //! 3/4
+    static std::size_t capacity_for(std::size_t n) {
+        std::size_t c = min_capacity;
+        while (c / 4 * 3 < n) c *= 2;
+        return c;
+    }
+
+    //! \return the index slot of the entry with key `k` and hash `h`, or of
+    //! the empty slot ending its probe sequence
+    std::size_t find_slot(const Key &k, std::size_t h) const {
+        std::uint32_t tag = static_cast<std::uint32_t>(h);
+        for (std::size_t i = home(h); ; i = next(i)) {
+            const Slot &s = index_[i];
+            if (s.entry == none) return i;
+            if (s.hash == tag) {
+                const Entry &e = entries_[s.entry];
+                if (e.hash == h and KeyEqual()(e.kv.first, k)) return i;
+            }
+        }
+    }
+
+    //! \return the position of the entry with key `k`, or `none`
+    std::uint32_t find_entry(const Key &k) const {
+        if (entries_.empty()) return none;
+        return index_[find_slot(k, static_cast<std::size_t>(Hash()(k)))].entry;
+    }
+
+    //! \return the index slot pointing to the entry at `pos`
+    std::size_t slot_of(std::uint32_t pos) const {
+        std::size_t i = home(entries_[pos].hash);
+        while (index_[i].entry != pos) i = next(i);
+        return i;
+    }
+
+    void rebuild_index(std::size_t capacity) {
+        index_.assign(capacity, Slot{0, none});
+        shift_ = 64;
+        for (std::size_t c = capacity; c > 1; c /= 2) shift_--;
+        for (std::size_t j = 0; j < entries_.size(); j++) {
+            std::size_t i = home(entries_[j].hash);
+            while (index_[i].entry != none) i = next(i);
+            index_[i].hash = static_cast<std::uint32_t>(entries_[j].hash);
+            index_[i].entry = static_cast<std::uint32_t>(j);
+        }
+    }
+
+    template<class V>
+    std::pair<std::uint32_t, bool> insert_value(V &&v) {
+        std::size_t h = static_cast<std::size_t>(Hash()(v.first));
+        std::size_t i;
+        if (index_.size() / 4 * 3 < entries_.size() + 1) {
+            if (not entries_.empty()) {
+                i = find_slot(v.first, h);
+                if (index_[i].entry != none)
+                    return std::make_pair(index_[i].entry, false);
+            }
+            rebuild_index(capacity_for(entries_.size() + 1));
+            i = home(h);
+            while (index_[i].entry != none) i = next(i);
+        } else {
+            i = find_slot(v.first, h);
+            if (index_[i].entry != none)
+                return std::make_pair(index_[i].entry, false);
+        }
+        std::uint32_t pos = static_cast<std::uint32_t>(entries_.size());
+        entries_.emplace_back(h, std::forward<V>(v));
+        index_[i].hash = static_cast<std::uint32_t>(h);
+        index_[i].entry = pos;
+        return std::make_pair(pos, true);
+    }
+
+    //! Erases the entry at `pos`, moving the last entry in its place
+    void erase_entry(std::uint32_t pos) {
+        // Empty the slot and move back the slots of its cluster that are
+        // not at their home slot, so that lookups need no tombstones
+        std::size_t i = slot_of(pos);
+        index_[i].entry = none;
+        for (std::size_t j = next(i); index_[j].entry != none; j = next(j)) {
+            std::size_t k = home(entries_[index_[j].entry].hash);
+            // The slot stays if its home slot is cyclically in (i, j]
+            if (i <= j ? (i < k and k <= j) : (i < k or k <= j)) continue;
+            index_[i] = index_[j];
+            index_[j].entry = none;
+            i = j;
+        }
+        std::uint32_t last = static_cast<std::uint32_t>(entries_.size() - 1);
+        if (pos != last) {
+            index_[slot_of(last)].entry = pos;
+            entries_[pos] = std::move(entries_[last]);
+        }
+        entries_.pop_back();
+    }
+
+    template<class E, class V>
+    class Iterator {
+    private:
+        E *p_;
+        explicit Iterator(E *p) : p_{p} {}
+        friend class FlatHashMap;
+        template<class, class> friend class Iterator;
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename FlatHashMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef V *pointer;
+        typedef V &reference;
+
+        Iterator() : p_{nullptr} {}
+        //! Converts an `iterator` to a `const_iterator`
+        template<class E2, class V2>
+        Iterator(const Iterator<E2, V2> &o) : p_{o.p_} {}
+
+        reference operator*() const { return p_->kv; }
+        pointer operator->() const { return &p_->kv; }
+        Iterator &operator++() {
+            ++p_;
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator r = *this;
+            ++p_;
+            return r;
+        }
+        template<class E2, class V2>
+        bool operator==(const Iterator<E2, V2> &o) const {
+            return p_ == o.p_;
+        }
+        template<class E2, class V2>
+        bool operator!=(const Iterator<E2, V2> &o) const {
+            return p_ != o.p_;
+        }
+    };
+
+public:
+    typedef Iterator<Entry, value_type> iterator;
+    typedef Iterator<const Entry, const value_type> const_iterator;
+
+    FlatHashMap() : shift_{64} {}
+
+    FlatHashMap(std::initializer_list<value_type> l) : FlatHashMap() {
+        reserve(l.size());
+        for (const auto &v: l) insert(v);
+    }
+
+    template<class InputIt>
+    FlatHashMap(InputIt first, InputIt last) : FlatHashMap() {
+        for (; first != last; ++first) insert(*first);
+    }
+
+    void swap(FlatHashMap &o) {
+        entries_.swap(o.entries_);
+        index_.swap(o.index_);
+        std::swap(shift_, o.shift_);
+    }
+
+    std::size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+    //! Makes room for `n` entries without growing the map
+    void reserve(std::size_t n) {
+        entries_.reserve(n);
+        std::size_t c = capacity_for(n);
+        if (c > index_.size()) rebuild_index(c);
+    }
+
+    //! Removes all the entries, keeping the memory of the map
+    void clear() {
+        entries_.clear();
+        index_.assign(index_.size(), Slot{0, none});
+    }
+
+    iterator begin() { return iterator(entries_.data()); }
+    iterator end() { return iterator(entries_.data() + entries_.size()); }
+    const_iterator begin() const { return const_iterator(entries_.data()); }
+    const_iterator end() const {
+        return const_iterator(entries_.data() + entries_.size());
+    }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    iterator find(const Key &k) {
+        std::uint32_t pos = find_entry(k);
+        return pos == none ? end() : iterator(&entries_[pos]);
+    }
+    const_iterator find(const Key &k) const {
+        std::uint32_t pos = find_entry(k);
+        return pos == none ? end() : const_iterator(&entries_[pos]);
+    }
+    std::size_t count(const Key &k) const {
+        return find_entry(k) == none ? 0 : 1;
+    }
+    //! \return the value of `k`, throws `std::out_of_range` if not found
+    const T &at(const Key &k) const {
+        std::uint32_t pos = find_entry(k);
+        if (pos == none) throw std::out_of_range("FlatHashMap::at");
+        return entries_[pos].kv.second;
+    }
+
+    //! Inserts `v` if its key is not in the map
+    //! \return the entry with the key and whether `v` was inserted
+    std::pair<iterator, bool> insert(const value_type &v) {
+        std::pair<std::uint32_t, bool> r = insert_value(v);
+        return std::make_pair(iterator(&entries_[r.first]), r.second);
+    }
+    std::pair<iterator, bool> insert(value_type &&v) {
+        std::pair<std::uint32_t, bool> r = insert_value(std::move(v));
+        return std::make_pair(iterator(&entries_[r.first]), r.second);
+    }
+    template<class P>
+    std::pair<iterator, bool> insert(P &&p) {
+        return insert(value_type(std::forward<P>(p)));
+    }
+
+    void erase(const_iterator it) {
+        erase_entry(static_cast<std::uint32_t>(it.p_ - entries_.data()));
+    }
+    std::size_t erase(const Key &k) {
+        std::uint32_t pos = find_entry(k);
+        if (pos == none) return 0;
+        erase_entry(pos);
+        return 1;
+    }
+};
+
+} // SymEngine
+
+#endif
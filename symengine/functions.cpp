@@ -272,14 +272,7 @@ RCP<const Basic> TrigFunction::create(const RCP<const Basic> &arg) const
 
 RCP<const Basic> TrigFunction::subs(const map_basic_basic &subs_dict) const
 {
-    auto it = subs_dict.find(rcp_from_this());
-    if (it != subs_dict.end())
-        return it->second;
-    RCP<const Basic> arg = arg_->subs(subs_dict);
-    if (arg == arg_)
-        return rcp_from_this();
-    else
-        return this->create(arg);
+    return SubsVisitor(subs_dict).apply(rcp_from_this());
 }
 
 Sin::Sin(const RCP<const Basic> &arg)
@@ -1499,14 +1492,7 @@ RCP<const Basic> FunctionSymbol::create(const vec_basic &x) const {
 
 RCP<const Basic> FunctionSymbol::subs(const map_basic_basic &subs_dict) const
 {
-    auto it = subs_dict.find(rcp_from_this());
-    if (it != subs_dict.end())
-        return it->second;
-    vec_basic v = arg_;
-    for (auto & elem : v) {
-        elem = elem->subs(subs_dict);
-    }
-    return create(v);
+    return SubsVisitor(subs_dict).apply(rcp_from_this());
 }
 
 RCP<const Basic> function_symbol(std::string name, const vec_basic &arg)
@@ -1776,14 +1762,7 @@ RCP<const Basic> HyperbolicFunction::create(const RCP<const Basic> &arg) const
 
 RCP<const Basic> HyperbolicFunction::subs(const map_basic_basic &subs_dict) const
 {
-    auto it = subs_dict.find(rcp_from_this());
-    if (it != subs_dict.end())
-        return it->second;
-    RCP<const Basic> arg = arg_->subs(subs_dict);
-    if (arg == arg_)
-        return rcp_from_this();
-    else
-        return this->create(arg);
+    return SubsVisitor(subs_dict).apply(rcp_from_this());
 }
 
 Sinh::Sinh(const RCP<const Basic> &arg)
@@ -28,6 +28,7 @@ public:
     //! \return `arg_`
     inline RCP<const Basic> get_arg() const { return arg_; }
     virtual vec_basic get_args() const { return {arg_}; }
+    virtual void for_each_arg(const ArgFunction &f) const { f(*arg_); }
     //! Method to construct classes with canonicalization
     virtual RCP<const Basic> create(const RCP<const Basic> &arg) const;
     //! Substitute with `subs_dict`
@@ -342,6 +343,10 @@ public:
     }
 
     virtual vec_basic get_args() const { return {num_, den_}; }
+    virtual void for_each_arg(const ArgFunction &f) const {
+        f(*num_);
+        f(*den_);
+    }
 };
 
 //! Canonicalize ATan2:
@@ -372,6 +377,7 @@ public:
     //! \return `arg_`
     inline RCP<const Basic> get_arg() const { return arg_; }
     virtual vec_basic get_args() const { return {arg_}; }
+    virtual void for_each_arg(const ArgFunction &f) const { f(*arg_); }
     //! \return `true` if canonical
     bool is_canonical(const RCP<const Basic> &arg) const;
 };
@@ -414,6 +420,10 @@ public:
     //! \return `a_`
     inline RCP<const Basic> get_a() const { return a_; }
     virtual vec_basic get_args() const { return {s_, a_}; }
+    virtual void for_each_arg(const ArgFunction &f) const {
+        f(*s_);
+        f(*a_);
+    }
     //! \return `true` if canonical
     bool is_canonical(const RCP<const Basic> &s, const RCP<const Basic> &a) const;
 };
@@ -443,6 +453,7 @@ public:
     //! \return `s_`
     inline RCP<const Basic> get_s() const { return s_; }
     virtual vec_basic get_args() const { return {s_}; }
+    virtual void for_each_arg(const ArgFunction &f) const { f(*s_); }
     //! \return `true` if canonical
     bool is_canonical(const RCP<const Basic> &s) const;
     //! Rewrites in the form of zeta
@@ -474,6 +485,9 @@ public:
     inline std::string get_name() const { return name_; }
     //! \return `arg_`
     virtual vec_basic get_args() const { return arg_; }
+    virtual void for_each_arg(const ArgFunction &f) const {
+        for (const auto &a: arg_) f(*a);
+    }
     //! \return `true` if canonical
     bool is_canonical(const vec_basic &arg) const;
     virtual RCP<const Basic> subs(const map_basic_basic &subs_dict) const;
@@ -541,6 +555,10 @@ public:
         args.insert(args.end(), x_.begin(), x_.end());
         return args;
     }
+    virtual void for_each_arg(const ArgFunction &f) const {
+        f(*arg_);
+        for (const auto &p: x_) f(*p);
+    }
     bool is_canonical(const RCP<const Basic> &arg, const multiset_basic &x) const;
     virtual RCP<const Basic> subs(const map_basic_basic &subs_dict) const;
 };
@@ -594,6 +612,7 @@ public:
     //! \return `arg_`
     inline RCP<const Basic> get_arg() const { return arg_; }
     virtual vec_basic get_args() const { return {arg_}; }
+    virtual void for_each_arg(const ArgFunction &f) const { f(*arg_); }
     //! Method to construct classes with canonicalization
     virtual RCP<const Basic> create(const RCP<const Basic> &arg) const;
     //! Substitute with `subs_dict`
@@ -890,6 +909,10 @@ public:
     //! \return `true` if canonical
     bool is_canonical(const RCP<const Basic> &i, const RCP<const Basic> &j) const;
     virtual vec_basic get_args() const { return {i_, j_}; }
+    virtual void for_each_arg(const ArgFunction &f) const {
+        f(*i_);
+        f(*j_);
+    }
 };
 
 //! Canonicalize KroneckerDelta:
@@ -920,6 +943,9 @@ public:
     //! \return `true` if canonical
     bool is_canonical(const vec_basic &arg) const;
     virtual vec_basic get_args() const { return arg_; }
+    virtual void for_each_arg(const ArgFunction &f) const {
+        for (const auto &a: arg_) f(*a);
+    }
 };
 
 //! Canonicalize LeviCivita:
@@ -952,7 +978,10 @@ public:
     virtual std::size_t __hash__() const;
     //! \return `true` if canonical
     bool is_canonical(const RCP<const Basic> &arg) const;
+    //! \return `arg_`
+    inline RCP<const Basic> get_arg() const { return arg_; }
     virtual vec_basic get_args() const { return {arg_}; }
+    virtual void for_each_arg(const ArgFunction &f) const { f(*arg_); }
 };
 
 //! Canonicalize Gamma:
@@ -978,6 +1007,10 @@ public:
     //! \return `true` if canonical
     bool is_canonical(const RCP<const Basic> &s, const RCP<const Basic> &x) const;
     virtual vec_basic get_args() const { return {s_, x_}; }
+    virtual void for_each_arg(const ArgFunction &f) const {
+        f(*s_);
+        f(*x_);
+    }
 };
 
 //! Canonicalize LowerGamma:
@@ -1004,6 +1037,10 @@ public:
     //! \return `true` if canonical
     bool is_canonical(const RCP<const Basic> &s, const RCP<const Basic> &x) const;
     virtual vec_basic get_args() const { return {s_, x_}; }
+    virtual void for_each_arg(const ArgFunction &f) const {
+        f(*s_);
+        f(*x_);
+    }
 };
 
 //! Canonicalize UpperGamma:
@@ -1039,6 +1076,10 @@ public:
     //! \return `true` if canonical
     bool is_canonical(const RCP<const Basic> &s, const RCP<const Basic> &x);
     virtual vec_basic get_args() const { return {x_, y_}; }
+    virtual void for_each_arg(const ArgFunction &f) const {
+        f(*x_);
+        f(*y_);
+    }
     RCP<const Basic> rewrite_as_gamma() const;
 };
 
@@ -1074,6 +1115,10 @@ public:
     virtual std::size_t __hash__() const;
     bool is_canonical(const RCP<const Basic> &n, const RCP<const Basic> &x);
     virtual vec_basic get_args() const { return {n_, x_}; }
+    virtual void for_each_arg(const ArgFunction &f) const {
+        f(*n_);
+        f(*x_);
+    }
     RCP<const Basic> rewrite_as_zeta() const;
 };
 
@@ -1102,6 +1147,7 @@ public:
     bool is_canonical(const RCP<const Basic> &arg) const;
     inline RCP<const Basic> get_arg() const { return arg_; }
     virtual vec_basic get_args() const { return {arg_}; }
+    virtual void for_each_arg(const ArgFunction &f) const { f(*arg_); }
 };
 
 //! Canonicalize Abs:
@@ -7,10 +7,9 @@ namespace SymEngine {
 
 std::size_t Integer::__hash__() const
 {
-    std::hash<long long int> hash_fn;
-    // only the least significant bits that fit into "signed long int" are
-    // hashed:
-    return hash_fn(this->i.get_si());
+    // only the least significant bits that fit into "signed long long int"
+    // are hashed:
+    return stable_hash<long long int>(mpz_hash_bits(this->i.get_mpz_t()));
 }
 
 bool Integer::__eq__(const Basic &o) const
@@ -7,21 +7,157 @@
 #ifndef SYMENGINE_INTEGER_H
 #define SYMENGINE_INTEGER_H
 
+#include <climits>
+#include <cstdlib>
+
 #include <symengine/basic.h>
 #include <symengine/number.h>
 
 namespace SymEngine {
 
+/* Overflow checked arithmetic on machine integers, used by the fast paths of
+ * Integer and Rational. They return false if the result does not fit. */
+inline bool checked_add(long a, long b, long &r)
+{
+#if defined(__clang__) or (defined(__GNUC__) and __GNUC__ >= 5)
+    return not __builtin_add_overflow(a, b, &r);
+#else
+    if ((b > 0 and a > LONG_MAX - b) or (b < 0 and a < LONG_MIN - b))
+        return false;
+    r = a + b;
+    return true;
+#endif
+}
+
+inline bool checked_sub(long a, long b, long &r)
+{
+#if defined(__clang__) or (defined(__GNUC__) and __GNUC__ >= 5)
+    return not __builtin_sub_overflow(a, b, &r);
+#else
+    if ((b < 0 and a > LONG_MAX + b) or (b > 0 and a < LONG_MIN + b))
+        return false;
+    r = a - b;
+    return true;
+#endif
+}
+
+inline bool checked_mul(long a, long b, long &r)
+{
+#if defined(__clang__) or (defined(__GNUC__) and __GNUC__ >= 5)
+    return not __builtin_mul_overflow(a, b, &r);
+#else
+    // Only products of factors of half the width are done directly
+    const long half = 1L << (sizeof(long) * 4 - 1);
+    if (a >= half or a <= -half or b >= half or b <= -half) return false;
+    r = a * b;
+    return true;
+#endif
+}
+
+//! Greatest common divisor of `a, b >= 0`
+inline unsigned long ulong_gcd(unsigned long a, unsigned long b)
+{
+    while (b != 0) {
+        unsigned long t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/*! Sets `z` to `v` using the single limb `*limb` as its storage, so that no
+    memory is allocated: `z` is cleared and set up by `mpz_roinit_n()`. `z`
+    must be initialized, and it is read only afterwards: it cannot be the
+    output of a GMP function and has to be released with
+    `mpz_release_inline()`.
+    \return false if `v` needs more than one limb, `z` is unchanged then.
+*/
+inline bool mpz_set_inline(mpz_ptr z, mp_limb_t *limb, bool negative,
+        unsigned long long v)
+{
+    if (v > static_cast<unsigned long long>(~mp_limb_t(0))) return false;
+    mpz_clear(z);
+    *limb = static_cast<mp_limb_t>(v);
+    mpz_roinit_n(z, limb, v == 0 ? 0 : (negative ? -1 : 1));
+    return true;
+}
+
+//! Sets `z` to `v` as `mpz_set_inline()` if the value of `v` has one limb
+inline void mpz_set_inline(mpz_ptr z, mp_limb_t *limb, mpz_ptr v)
+{
+    if (mpz_size(v) <= 1) {
+        mpz_set_inline(z, limb, mpz_sgn(v) < 0, mpz_getlimbn(v, 0));
+    } else {
+        mpz_swap(z, v);
+    }
+}
+
+//! Puts `z` back in a state where it can be cleared by `mpz_clear()`
+inline void mpz_release_inline(mpz_ptr z, const mp_limb_t *limb)
+{
+    if (mpz_limbs_read(z) == limb) mpz_init(z);
+}
+
+//! \return true and the value of `z` in `v` if it fits in a `long`
+inline bool mpz_get_small(mpz_srcptr z, long &v)
+{
+    if (mpz_size(z) > 1) return false;
+    mp_limb_t l = mpz_getlimbn(z, 0);
+    if (l > static_cast<mp_limb_t>(LONG_MAX)) return false;
+    v = mpz_sgn(z) < 0 ? -static_cast<long>(l) : static_cast<long>(l);
+    return true;
+}
+
+/*! \return the value hashed for `z`: its least significant 63 bits with its
+    sign, as `mpz_get_si()` gives them where `long` has 64 bits. The result
+    does not depend on the size of `long` or of the limbs. */
+inline long long int mpz_hash_bits(mpz_srcptr z)
+{
+    if (mpz_sgn(z) == 0) return 0;
+    unsigned long long low = 0;
+    mp_size_t n = mpz_size(z);
+    for (mp_size_t k = 0; k < n and k * GMP_NUMB_BITS < 64; k++)
+        low |= static_cast<unsigned long long>(mpz_getlimbn(z, k))
+            << (k * GMP_NUMB_BITS);
+    if (mpz_sgn(z) > 0) return static_cast<long long int>(low & LLONG_MAX);
+    return -1 - static_cast<long long int>((low - 1) & LLONG_MAX);
+}
+
 //! Integer Class
 class Integer : public Number {
 public:
     //! `i` : object of `mpz_class`
     mpz_class i;
 
+private:
+    //! Storage of `i` when it has a single limb, so that small integers do
+    //! not allocate memory in GMP. `i` is read only, see `mpz_set_inline()`.
+    mp_limb_t limb_;
+
+    void init(bool negative, unsigned long long v) {
+        if (mpz_set_inline(i.get_mpz_t(), &limb_, negative, v)) return;
+        mpz_import(i.get_mpz_t(), 1, -1, sizeof(v), 0, 0, &v);
+        if (negative) mpz_neg(i.get_mpz_t(), i.get_mpz_t());
+    }
+
 public:
     IMPLEMENT_TYPEID(INTEGER)
     //! Constructor of Integer using `mpz_class`
     explicit Integer(mpz_class i);
+    //! Constructor of Integer from a signed machine integer
+    template <typename T, typename std::enable_if<std::is_integral<T>::value
+        and std::is_signed<T>::value, int>::type = 0>
+    explicit Integer(T i) {
+        init(i < 0, i < 0 ? 0ULL - static_cast<unsigned long long>(i)
+            : static_cast<unsigned long long>(i));
+    }
+    //! Constructor of Integer from an unsigned machine integer
+    template <typename T, typename std::enable_if<std::is_integral<T>::value
+        and std::is_unsigned<T>::value, int>::type = 0>
+    explicit Integer(T i) {
+        init(false, i);
+    }
+    ~Integer() { mpz_release_inline(i.get_mpz_t(), &limb_); }
     //! \return size of the hash
     virtual std::size_t __hash__() const;
     /*! Equality comparator
@@ -33,6 +169,10 @@ public:
 
     //! Convert to `int`, raise an exception if it does not fit
     signed long int as_int() const;
+    //! \return true and the value in `v` if it fits in a `long`
+    inline bool get_small(long &v) const {
+        return mpz_get_small(i.get_mpz_t(), v);
+    }
     //! Convert to `mpz_class`.
     inline mpz_class as_mpz() const { return this->i; }
     //! \return `true` if `0`
@@ -49,14 +189,23 @@ public:
     /* These are very fast methods for add/sub/mul/div/pow on Integers only */
     //! Fast Integer Addition
     inline RCP<const Integer> addint(const Integer &other) const {
+        long a, b, r;
+        if (get_small(a) and other.get_small(b) and checked_add(a, b, r))
+            return make_rcp<const Integer>(r);
         return make_rcp<const Integer>(this->i + other.i);
     }
     //! Fast Integer Subtraction
     inline RCP<const Integer> subint(const Integer &other) const {
+        long a, b, r;
+        if (get_small(a) and other.get_small(b) and checked_sub(a, b, r))
+            return make_rcp<const Integer>(r);
         return make_rcp<const Integer>(this->i - other.i);
     }
     //! Fast Integer Multiplication
     inline RCP<const Integer> mulint(const Integer &other) const {
+        long a, b, r;
+        if (get_small(a) and other.get_small(b) and checked_mul(a, b, r))
+            return make_rcp<const Integer>(r);
         return make_rcp<const Integer>(this->i * other.i);
     }
     //!  Integer Division
@@ -77,6 +226,8 @@ public:
     }
     //! \return negative of self.
     inline RCP<const Integer> neg() const {
+        long a;
+        if (get_small(a) and a != LONG_MIN) return make_rcp<const Integer>(-a);
         return make_rcp<const Integer>(-i);
     }
 
@@ -166,7 +317,10 @@ int perfect_power(const Integer &n);
 //! Integer Absolute value
 RCP<const Integer> iabs(const Integer &n);
 
-inline Integer::Integer(mpz_class i) : i{i} {}
+inline Integer::Integer(mpz_class i)
+{
+    mpz_set_inline(this->i.get_mpz_t(), &limb_, i.get_mpz_t());
+}
 
 } // SymEngine
 
@@ -0,0 +1,675 @@
+#include <algorithm>
+#include <cstring>
+
+#include <symengine/lambda_bytecode.h>
+#include <symengine/visitor.h>
+#include <symengine/matrix.h>
+
+namespace SymEngine {
+
+//! Evaluates a single operation, used both when running the bytecode and
+//! when folding constants during compilation.
+inline double bytecode_eval(BytecodeOp op, double a, double b)
+{
+    switch (op) {
+        case BytecodeOp::Add: return a + b;
+        case BytecodeOp::Sub: return a - b;
+        case BytecodeOp::Mul: return a * b;
+        case BytecodeOp::Div: return a / b;
+        case BytecodeOp::Pow: return std::pow(a, b);
+        case BytecodeOp::ATan2: return std::atan2(a, b);
+        case BytecodeOp::Neg: return -a;
+        case BytecodeOp::Inv: return 1.0 / a;
+        case BytecodeOp::Sqrt: return std::sqrt(a);
+        case BytecodeOp::Exp: return std::exp(a);
+        case BytecodeOp::Log: return std::log(a);
+        case BytecodeOp::Abs: return std::abs(a);
+        case BytecodeOp::Gamma: return std::tgamma(a);
+        case BytecodeOp::Sin: return std::sin(a);
+        case BytecodeOp::Cos: return std::cos(a);
+        case BytecodeOp::Tan: return std::tan(a);
+        case BytecodeOp::ASin: return std::asin(a);
+        case BytecodeOp::ACos: return std::acos(a);
+        case BytecodeOp::ATan: return std::atan(a);
+        case BytecodeOp::Sinh: return std::sinh(a);
+        case BytecodeOp::Cosh: return std::cosh(a);
+        case BytecodeOp::Tanh: return std::tanh(a);
+        case BytecodeOp::ASinh: return std::asinh(a);
+        case BytecodeOp::ACosh: return std::acosh(a);
+        case BytecodeOp::ATanh: return std::atanh(a);
+    }
+    return 0;
+}
+
+/*
+   Lowers a Basic tree into instructions. Registers are numbered in the order
+   they are created (the input symbols first) and 'finalize()' then drops dead
+   instructions and computes the final register layout.
+*/
+class LambdaBytecodeCompiler : public BaseVisitor<LambdaBytecodeCompiler> {
+protected:
+    std::vector<BytecodeInstruction> code_;
+    std::vector<bool> is_const_;
+    std::vector<double> value_;
+    unsigned n_inputs_;
+    unsigned result_;
+    std::unordered_map<RCP<const Basic>, unsigned,
+        RCPBasicHash, RCPBasicKeyEq> cache_;
+    std::map<std::tuple<BytecodeOp, unsigned, unsigned>, unsigned> instr_cache_;
+    std::unordered_map<uint64_t, unsigned> const_cache_;
+
+    unsigned new_register(bool is_const, double value) {
+        is_const_.push_back(is_const);
+        value_.push_back(value);
+        return is_const_.size() - 1;
+    }
+
+public:
+    LambdaBytecodeCompiler(const vec_basic &x) : n_inputs_(x.size()) {
+        for (unsigned i = 0; i < x.size(); i++) {
+            new_register(false, 0);
+            // The first occurrence of a symbol wins, as in LambdaDoubleVisitor
+            cache_.insert(std::make_pair(x[i], i));
+        }
+    }
+
+    unsigned constant(double v) {
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        auto it = const_cache_.find(bits);
+        if (it != const_cache_.end()) return it->second;
+        unsigned r = new_register(true, v);
+        const_cache_[bits] = r;
+        return r;
+    }
+
+    inline bool is_constant(unsigned r, double v) const {
+        return is_const_[r] and value_[r] == v;
+    }
+
+    unsigned emit(BytecodeOp op, unsigned a, unsigned b) {
+        if (not is_binary(op)) {
+            b = a;
+        } else if ((op == BytecodeOp::Add or op == BytecodeOp::Mul) and a > b) {
+            std::swap(a, b);
+        }
+        if (is_const_[a] and is_const_[b]) {
+            return constant(bytecode_eval(op, value_[a], value_[b]));
+        }
+        switch (op) {
+            case BytecodeOp::Add:
+                if (is_constant(a, 0)) return b;
+                if (is_constant(b, 0)) return a;
+                break;
+            case BytecodeOp::Sub:
+                if (is_constant(b, 0)) return a;
+                if (is_constant(a, 0)) return emit(BytecodeOp::Neg, b, b);
+                break;
+            case BytecodeOp::Mul:
+                if (is_constant(a, 1)) return b;
+                if (is_constant(b, 1)) return a;
+                if (is_constant(a, -1)) return emit(BytecodeOp::Neg, b, b);
+                if (is_constant(b, -1)) return emit(BytecodeOp::Neg, a, a);
+                break;
+            case BytecodeOp::Div:
+                if (is_constant(b, 1)) return a;
+                if (is_constant(a, 1)) return emit(BytecodeOp::Inv, b, b);
+                break;
+            default:
+                break;
+        }
+        auto key = std::make_tuple(op, a, b);
+        auto it = instr_cache_.find(key);
+        if (it != instr_cache_.end()) return it->second;
+        unsigned r = new_register(false, 0);
+        code_.push_back({op, r, a, b});
+        instr_cache_[key] = r;
+        return r;
+    }
+
+    inline unsigned emit(BytecodeOp op, unsigned a) {
+        return emit(op, a, a);
+    }
+
+    unsigned apply(const Basic &b) {
+        RCP<const Basic> key = b.rcp_from_this();
+        auto it = cache_.find(key);
+        if (it != cache_.end()) return it->second;
+        b.accept(*this);
+        cache_[key] = result_;
+        return result_;
+    }
+
+    unsigned pow_int(unsigned base, long n) {
+        if (n == 0) return constant(1.0);
+        if (n < 0) return emit(BytecodeOp::Inv, pow_int(base, -n));
+        // Binary exponentiation, the squares are shared through instr_cache_
+        unsigned r = 0;
+        bool have_r = false;
+        while (true) {
+            if (n & 1) {
+                r = have_r ? emit(BytecodeOp::Mul, r, base) : base;
+                have_r = true;
+            }
+            n >>= 1;
+            if (n == 0) break;
+            base = emit(BytecodeOp::Mul, base, base);
+        }
+        return r;
+    }
+
+    unsigned pow(const RCP<const Basic> &base, const RCP<const Basic> &exp) {
+        if (eq(*base, *E)) return emit(BytecodeOp::Exp, apply(*exp));
+        if (is_a<Integer>(*exp)) {
+            const mpz_class &n = static_cast<const Integer &>(*exp).i;
+            if (n.fits_slong_p() and std::abs(n.get_si()) <= 64) {
+                return pow_int(apply(*base), n.get_si());
+            }
+        } else if (is_a<Rational>(*exp)) {
+            const mpq_class &q = static_cast<const Rational &>(*exp).i;
+            if (q == mpq_class(1, 2)) {
+                return emit(BytecodeOp::Sqrt, apply(*base));
+            } else if (q == mpq_class(-1, 2)) {
+                return emit(BytecodeOp::Inv,
+                    emit(BytecodeOp::Sqrt, apply(*base)));
+            }
+        }
+        return emit(BytecodeOp::Pow, apply(*base), apply(*exp));
+    }
+
+    void bvisit(const Symbol &x) {
+        // All known symbols are already in the cache
+        throw std::runtime_error("Symbol not in the symbols vector.");
+    }
+
+    void bvisit(const Integer &x) {
+        result_ = constant(x.i.get_d());
+    }
+
+    void bvisit(const Rational &x) {
+        result_ = constant(x.i.get_d());
+    }
+
+    void bvisit(const RealDouble &x) {
+        result_ = constant(x.i);
+    }
+
+#ifdef HAVE_SYMENGINE_MPFR
+    void bvisit(const RealMPFR &x) {
+        result_ = constant(mpfr_get_d(x.i.get_mpfr_t(), MPFR_RNDN));
+    }
+#endif
+
+    void bvisit(const Constant &x) {
+        if (eq(x, *pi)) {
+            result_ = constant(std::atan2(0, -1));
+        } else if (eq(x, *E)) {
+            result_ = constant(std::exp(1));
+        } else {
+            throw std::runtime_error("Constant " + x.get_name() + " is not implemented.");
+        }
+    }
+
+    void bvisit(const Add &x) {
+        unsigned r = apply(*x.coef_);
+        for (const auto &p: x.dict_) {
+            unsigned t = apply(*p.first);
+            if (p.second->is_minus_one()) {
+                r = emit(BytecodeOp::Sub, r, t);
+            } else {
+                r = emit(BytecodeOp::Add, r,
+                    emit(BytecodeOp::Mul, apply(*p.second), t));
+            }
+        }
+        result_ = r;
+    }
+
+    void bvisit(const Mul &x) {
+        // Factors with a negative numerical exponent are collected into a
+        // single denominator, so `x/(y*z)` needs one division only.
+        unsigned num = apply(*x.coef_), den = constant(1.0);
+        for (const auto &p: x.dict_) {
+            if (is_a_Number(*p.second) and
+                    rcp_static_cast<const Number>(p.second)->is_negative()) {
+                den = emit(BytecodeOp::Mul, den, pow(p.first,
+                    mulnum(rcp_static_cast<const Number>(p.second), minus_one)));
+            } else {
+                num = emit(BytecodeOp::Mul, num, pow(p.first, p.second));
+            }
+        }
+        result_ = emit(BytecodeOp::Div, num, den);
+    }
+
+    void bvisit(const Pow &x) {
+        result_ = pow(x.get_base(), x.get_exp());
+    }
+
+    void bvisit(const Log &x) {
+        result_ = emit(BytecodeOp::Log, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Abs &x) {
+        result_ = emit(BytecodeOp::Abs, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Gamma &x) {
+        result_ = emit(BytecodeOp::Gamma, apply(*x.get_args()[0]));
+    }
+
+    void bvisit(const ATan2 &x) {
+        result_ = emit(BytecodeOp::ATan2, apply(*x.get_num()),
+            apply(*x.get_den()));
+    }
+
+    void bvisit(const Sin &x) {
+        result_ = emit(BytecodeOp::Sin, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Cos &x) {
+        result_ = emit(BytecodeOp::Cos, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Tan &x) {
+        result_ = emit(BytecodeOp::Tan, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Cot &x) {
+        result_ = emit(BytecodeOp::Inv,
+            emit(BytecodeOp::Tan, apply(*x.get_arg())));
+    }
+
+    void bvisit(const Csc &x) {
+        result_ = emit(BytecodeOp::Inv,
+            emit(BytecodeOp::Sin, apply(*x.get_arg())));
+    }
+
+    void bvisit(const Sec &x) {
+        result_ = emit(BytecodeOp::Inv,
+            emit(BytecodeOp::Cos, apply(*x.get_arg())));
+    }
+
+    void bvisit(const ASin &x) {
+        result_ = emit(BytecodeOp::ASin, apply(*x.get_arg()));
+    }
+
+    void bvisit(const ACos &x) {
+        result_ = emit(BytecodeOp::ACos, apply(*x.get_arg()));
+    }
+
+    void bvisit(const ASec &x) {
+        result_ = emit(BytecodeOp::ACos,
+            emit(BytecodeOp::Inv, apply(*x.get_arg())));
+    }
+
+    void bvisit(const ACsc &x) {
+        result_ = emit(BytecodeOp::ASin,
+            emit(BytecodeOp::Inv, apply(*x.get_arg())));
+    }
+
+    void bvisit(const ATan &x) {
+        result_ = emit(BytecodeOp::ATan, apply(*x.get_arg()));
+    }
+
+    void bvisit(const ACot &x) {
+        result_ = emit(BytecodeOp::ATan,
+            emit(BytecodeOp::Inv, apply(*x.get_arg())));
+    }
+
+    void bvisit(const Sinh &x) {
+        result_ = emit(BytecodeOp::Sinh, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Csch &x) {
+        result_ = emit(BytecodeOp::Inv,
+            emit(BytecodeOp::Sinh, apply(*x.get_arg())));
+    }
+
+    void bvisit(const Cosh &x) {
+        result_ = emit(BytecodeOp::Cosh, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Sech &x) {
+        result_ = emit(BytecodeOp::Inv,
+            emit(BytecodeOp::Cosh, apply(*x.get_arg())));
+    }
+
+    void bvisit(const Tanh &x) {
+        result_ = emit(BytecodeOp::Tanh, apply(*x.get_arg()));
+    }
+
+    void bvisit(const Coth &x) {
+        result_ = emit(BytecodeOp::Inv,
+            emit(BytecodeOp::Tanh, apply(*x.get_arg())));
+    }
+
+    void bvisit(const ASinh &x) {
+        result_ = emit(BytecodeOp::ASinh, apply(*x.get_arg()));
+    }
+
+    void bvisit(const ACsch &x) {
+        result_ = emit(BytecodeOp::ASinh,
+            emit(BytecodeOp::Inv, apply(*x.get_arg())));
+    }
+
+    void bvisit(const ACosh &x) {
+        result_ = emit(BytecodeOp::ACosh, apply(*x.get_arg()));
+    }
+
+    void bvisit(const ATanh &x) {
+        result_ = emit(BytecodeOp::ATanh, apply(*x.get_arg()));
+    }
+
+    void bvisit(const ACoth &x) {
+        result_ = emit(BytecodeOp::ATanh,
+            emit(BytecodeOp::Inv, apply(*x.get_arg())));
+    }
+
+    void bvisit(const ASech &x) {
+        result_ = emit(BytecodeOp::ACosh,
+            emit(BytecodeOp::Inv, apply(*x.get_arg())));
+    }
+
+    void bvisit(const Basic &) {
+        throw std::runtime_error("Not implemented.");
+    }
+
+    //! Removes dead instructions and maps the registers into the final
+    //! layout: inputs, constants, temporaries. If `reuse` is true, a
+    //! temporary is released right after its last reader, so the reader's
+    //! own result may reuse it. Otherwise every instruction gets its own
+    //! register, so all the intermediate values survive the evaluation.
+    void finalize(const std::vector<unsigned> &outputs,
+            std::vector<BytecodeInstruction> &code, std::vector<double> &regs,
+            std::vector<unsigned> &outputs_map, bool reuse = true) const {
+        const std::size_t n_regs = is_const_.size(), n_code = code_.size();
+        std::vector<bool> live(n_regs, false), keep(n_code, false);
+        for (unsigned o: outputs) live[o] = true;
+        for (std::size_t i = n_code; i-- > 0;) {
+            const BytecodeInstruction &ins = code_[i];
+            if (live[ins.dest]) {
+                keep[i] = true;
+                live[ins.a] = true;
+                live[ins.b] = true;
+            }
+        }
+        std::vector<std::size_t> last_use(n_regs, 0);
+        for (std::size_t i = 0; i < n_code; i++) {
+            if (keep[i]) {
+                last_use[code_[i].a] = i;
+                last_use[code_[i].b] = i;
+            }
+        }
+        for (unsigned o: outputs) last_use[o] = n_code;
+
+        std::vector<unsigned> map(n_regs, 0);
+        regs.assign(n_inputs_, 0.0);
+        for (unsigned i = 0; i < n_inputs_; i++) map[i] = i;
+        for (unsigned r = n_inputs_; r < n_regs; r++) {
+            if (is_const_[r] and live[r]) {
+                map[r] = regs.size();
+                regs.push_back(value_[r]);
+            }
+        }
+        auto is_temporary = [&](unsigned r) {
+            return r >= n_inputs_ and not is_const_[r];
+        };
+        std::vector<unsigned> free_regs;
+        code.clear();
+        for (std::size_t i = 0; i < n_code; i++) {
+            if (not keep[i]) continue;
+            const BytecodeInstruction &ins = code_[i];
+            if (reuse and is_temporary(ins.a) and last_use[ins.a] == i) {
+                free_regs.push_back(map[ins.a]);
+            }
+            if (reuse and ins.b != ins.a and is_temporary(ins.b)
+                    and last_use[ins.b] == i) {
+                free_regs.push_back(map[ins.b]);
+            }
+            if (free_regs.empty()) {
+                map[ins.dest] = regs.size();
+                regs.push_back(0.0);
+            } else {
+                map[ins.dest] = free_regs.back();
+                free_regs.pop_back();
+            }
+            code.push_back({ins.op, map[ins.dest], map[ins.a], map[ins.b]});
+        }
+        outputs_map.clear();
+        for (unsigned o: outputs) outputs_map.push_back(map[o]);
+    }
+};
+
+void LambdaRealDoubleBytecode::init(const vec_basic &x, const Basic &b)
+{
+    init(x, vec_basic({b.rcp_from_this()}));
+}
+
+void LambdaRealDoubleBytecode::init(const vec_basic &x, const vec_basic &b)
+{
+    compile(x, b, true);
+}
+
+void LambdaRealDoubleBytecode::compile(const vec_basic &x, const vec_basic &b,
+        bool reuse_registers)
+{
+    // A single compiler (and so a single subtree cache) is used for all the
+    // expressions, which gives common subexpression elimination across them.
+    LambdaBytecodeCompiler compiler(x);
+    std::vector<unsigned> outputs;
+    outputs.reserve(b.size());
+    for (const auto &p: b) {
+        outputs.push_back(compiler.apply(*p));
+    }
+    n_inputs_ = x.size();
+    compiler.finalize(outputs, code_, regs_, outputs_, reuse_registers);
+    batch_regs_.clear();
+}
+
+void LambdaRealDoubleBytecode::init(const vec_basic &x, const DenseMatrix &b)
+{
+    vec_basic entries;
+    entries.reserve(b.nrows() * b.ncols());
+    for (unsigned i = 0; i < b.nrows(); i++) {
+        for (unsigned j = 0; j < b.ncols(); j++) {
+            entries.push_back(b.get(i, j));
+        }
+    }
+    init(x, entries);
+}
+
+double LambdaRealDoubleBytecode::call(const std::vector<double> &vec)
+{
+    SYMENGINE_ASSERT(vec.size() >= n_inputs_)
+    double *r = regs_.data();
+    std::copy(vec.begin(), vec.begin() + n_inputs_, r);
+    for (const BytecodeInstruction &i: code_) {
+        r[i.dest] = bytecode_eval(i.op, r[i.a], r[i.b]);
+    }
+    return r[outputs_[0]];
+}
+
+void LambdaRealDoubleBytecode::call(double *outs, const double *inputs)
+{
+    double *r = regs_.data();
+    std::copy(inputs, inputs + n_inputs_, r);
+    for (const BytecodeInstruction &i: code_) {
+        r[i.dest] = bytecode_eval(i.op, r[i.a], r[i.b]);
+    }
+    for (std::size_t j = 0; j < outputs_.size(); j++) {
+        outs[j] = r[outputs_[j]];
+    }
+}
+
+#define SYMENGINE_BATCH_LOOP(expr) \
+    for (std::size_t k = 0; k < len; k++) d[k] = expr; \
+    break;
+
+void LambdaRealDoubleBytecode::call_batch(const double * const *inputs,
+        double *out, std::size_t n)
+{
+    SYMENGINE_ASSERT(outputs_.size() == 1)
+    call_batch(inputs, &out, n);
+}
+
+void LambdaRealDoubleBytecode::call_batch(const double * const *inputs,
+        double * const *outs, std::size_t n)
+{
+    const std::size_t bs = batch_size;
+    if (batch_regs_.size() != regs_.size() * bs) {
+        // Broadcast the constants, they are never overwritten
+        batch_regs_.resize(regs_.size() * bs);
+        for (std::size_t r = 0; r < regs_.size(); r++) {
+            std::fill_n(&batch_regs_[r * bs], bs, regs_[r]);
+        }
+    }
+    double *regs = batch_regs_.data();
+    for (std::size_t start = 0; start < n; start += bs) {
+        const std::size_t len = std::min(bs, n - start);
+        for (unsigned j = 0; j < n_inputs_; j++) {
+            std::copy(inputs[j] + start, inputs[j] + start + len,
+                regs + j * bs);
+        }
+        for (const BytecodeInstruction &i: code_) {
+            double *d = regs + i.dest * bs;
+            const double *a = regs + i.a * bs;
+            const double *b = regs + i.b * bs;
+            switch (i.op) {
+                case BytecodeOp::Add: SYMENGINE_BATCH_LOOP(a[k] + b[k])
+                case BytecodeOp::Sub: SYMENGINE_BATCH_LOOP(a[k] - b[k])
+                case BytecodeOp::Mul: SYMENGINE_BATCH_LOOP(a[k] * b[k])
+                case BytecodeOp::Div: SYMENGINE_BATCH_LOOP(a[k] / b[k])
+                case BytecodeOp::Pow: SYMENGINE_BATCH_LOOP(std::pow(a[k], b[k]))
+                case BytecodeOp::ATan2: SYMENGINE_BATCH_LOOP(std::atan2(a[k], b[k]))
+                case BytecodeOp::Neg: SYMENGINE_BATCH_LOOP(-a[k])
+                case BytecodeOp::Inv: SYMENGINE_BATCH_LOOP(1.0 / a[k])
+                case BytecodeOp::Sqrt: SYMENGINE_BATCH_LOOP(std::sqrt(a[k]))
+                case BytecodeOp::Exp: SYMENGINE_BATCH_LOOP(std::exp(a[k]))
+                case BytecodeOp::Log: SYMENGINE_BATCH_LOOP(std::log(a[k]))
+                case BytecodeOp::Abs: SYMENGINE_BATCH_LOOP(std::abs(a[k]))
+                case BytecodeOp::Gamma: SYMENGINE_BATCH_LOOP(std::tgamma(a[k]))
+                case BytecodeOp::Sin: SYMENGINE_BATCH_LOOP(std::sin(a[k]))
+                case BytecodeOp::Cos: SYMENGINE_BATCH_LOOP(std::cos(a[k]))
+                case BytecodeOp::Tan: SYMENGINE_BATCH_LOOP(std::tan(a[k]))
+                case BytecodeOp::ASin: SYMENGINE_BATCH_LOOP(std::asin(a[k]))
+                case BytecodeOp::ACos: SYMENGINE_BATCH_LOOP(std::acos(a[k]))
+                case BytecodeOp::ATan: SYMENGINE_BATCH_LOOP(std::atan(a[k]))
+                case BytecodeOp::Sinh: SYMENGINE_BATCH_LOOP(std::sinh(a[k]))
+                case BytecodeOp::Cosh: SYMENGINE_BATCH_LOOP(std::cosh(a[k]))
+                case BytecodeOp::Tanh: SYMENGINE_BATCH_LOOP(std::tanh(a[k]))
+                case BytecodeOp::ASinh: SYMENGINE_BATCH_LOOP(std::asinh(a[k]))
+                case BytecodeOp::ACosh: SYMENGINE_BATCH_LOOP(std::acosh(a[k]))
+                case BytecodeOp::ATanh: SYMENGINE_BATCH_LOOP(std::atanh(a[k]))
+            }
+        }
+        for (std::size_t j = 0; j < outputs_.size(); j++) {
+            const double *o = regs + outputs_[j] * bs;
+            std::copy(o, o + len, outs[j] + start);
+        }
+    }
+}
+
+#undef SYMENGINE_BATCH_LOOP
+
+//! The derivative of log(gamma(x)), needed for the adjoint of Gamma
+static double digamma(double x)
+{
+    double r = 0;
+    // Reflection for negative arguments, then recurrence up to x >= 6,
+    // where the asymptotic series is accurate to double precision.
+    if (x <= 0) {
+        const double pi = std::atan2(0, -1);
+        return digamma(1 - x) - pi / std::tan(pi * x);
+    }
+    while (x < 6) {
+        r -= 1 / x;
+        x += 1;
+    }
+    const double f = 1 / (x * x);
+    return r + std::log(x) - 0.5 / x - f * (1.0 / 12 - f * (1.0 / 120
+        - f * (1.0 / 252 - f * (1.0 / 240 - f / 132))));
+}
+
+void LambdaRealDoubleGradient::init(const vec_basic &x, const Basic &b)
+{
+    init(x, vec_basic({b.rcp_from_this()}));
+}
+
+void LambdaRealDoubleGradient::init(const vec_basic &x, const vec_basic &b)
+{
+    compile(x, b, false);
+    adj_.assign(regs_.size(), 0.0);
+}
+
+double LambdaRealDoubleGradient::call_gradient(const double *inputs,
+        double *grad, std::size_t output)
+{
+    SYMENGINE_ASSERT(output < outputs_.size())
+    double *r = regs_.data();
+    std::copy(inputs, inputs + n_inputs_, r);
+    for (const BytecodeInstruction &i: code_) {
+        r[i.dest] = bytecode_eval(i.op, r[i.a], r[i.b]);
+    }
+
+    double *adj = adj_.data();
+    std::fill(adj_.begin(), adj_.end(), 0.0);
+    adj[outputs_[output]] = 1;
+    for (std::size_t k = code_.size(); k-- > 0;) {
+        const BytecodeInstruction &i = code_[k];
+        const double g = adj[i.dest];
+        if (g == 0) continue;
+        const double a = r[i.a], b = r[i.b], d = r[i.dest];
+        switch (i.op) {
+            case BytecodeOp::Add:
+                adj[i.a] += g;
+                adj[i.b] += g;
+                break;
+            case BytecodeOp::Sub:
+                adj[i.a] += g;
+                adj[i.b] -= g;
+                break;
+            case BytecodeOp::Mul:
+                adj[i.a] += g * b;
+                adj[i.b] += g * a;
+                break;
+            case BytecodeOp::Div:
+                adj[i.a] += g / b;
+                adj[i.b] -= g * d / b;
+                break;
+            case BytecodeOp::Pow:
+                adj[i.a] += g * b * std::pow(a, b - 1);
+                // Only needed (and only defined for a > 0) if the exponent
+                // is not a constant
+                if (a > 0) adj[i.b] += g * d * std::log(a);
+                break;
+            case BytecodeOp::ATan2:
+                adj[i.a] += g * b / (a * a + b * b);
+                adj[i.b] -= g * a / (a * a + b * b);
+                break;
+            case BytecodeOp::Neg: adj[i.a] -= g; break;
+            case BytecodeOp::Inv: adj[i.a] -= g * d * d; break;
+            case BytecodeOp::Sqrt: adj[i.a] += g * 0.5 / d; break;
+            case BytecodeOp::Exp: adj[i.a] += g * d; break;
+            case BytecodeOp::Log: adj[i.a] += g / a; break;
+            case BytecodeOp::Abs:
+                adj[i.a] += a > 0 ? g : (a < 0 ? -g : 0);
+                break;
+            case BytecodeOp::Gamma: adj[i.a] += g * d * digamma(a); break;
+            case BytecodeOp::Sin: adj[i.a] += g * std::cos(a); break;
+            case BytecodeOp::Cos: adj[i.a] -= g * std::sin(a); break;
+            case BytecodeOp::Tan: adj[i.a] += g * (1 + d * d); break;
+            case BytecodeOp::ASin: adj[i.a] += g / std::sqrt(1 - a * a); break;
+            case BytecodeOp::ACos: adj[i.a] -= g / std::sqrt(1 - a * a); break;
+            case BytecodeOp::ATan: adj[i.a] += g / (1 + a * a); break;
+            case BytecodeOp::Sinh: adj[i.a] += g * std::cosh(a); break;
+            case BytecodeOp::Cosh: adj[i.a] += g * std::sinh(a); break;
+            case BytecodeOp::Tanh: adj[i.a] += g * (1 - d * d); break;
+            case BytecodeOp::ASinh: adj[i.a] += g / std::sqrt(a * a + 1); break;
+            case BytecodeOp::ACosh: adj[i.a] += g / std::sqrt(a * a - 1); break;
+            case BytecodeOp::ATanh: adj[i.a] += g / (1 - a * a); break;
+        }
+    }
+    std::copy(adj, adj + n_inputs_, grad);
+    return r[outputs_[output]];
+}
+
+} // SymEngine
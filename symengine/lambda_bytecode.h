@@ -0,0 +1,148 @@
+/**
+ *  \file lambda_bytecode.h
+ *  Register based bytecode evaluator for real double expressions
+ *
+ **/
+#ifndef SYMENGINE_LAMBDA_BYTECODE_H
+#define SYMENGINE_LAMBDA_BYTECODE_H
+
+#include <symengine/basic.h>
+
+namespace SymEngine {
+
+class DenseMatrix;
+
+//! Operations understood by `LambdaRealDoubleBytecode`.
+//! Binary operations come first, everything after `Neg` is unary.
+enum class BytecodeOp : unsigned char {
+    Add, Sub, Mul, Div, Pow, ATan2,
+    Neg, Inv, Sqrt, Exp, Log, Abs, Gamma,
+    Sin, Cos, Tan, ASin, ACos, ATan,
+    Sinh, Cosh, Tanh, ASinh, ACosh, ATanh
+};
+
+//! \return true if `op` reads both of its operands
+inline bool is_binary(BytecodeOp op)
+{
+    return op < BytecodeOp::Neg;
+}
+
+//! A single instruction `regs[dest] = op(regs[a], regs[b])`. Unary
+//! operations only read `regs[a]`.
+struct BytecodeInstruction {
+    BytecodeOp op;
+    unsigned dest, a, b;
+};
+
+/*! Evaluates an expression by compiling it into a flat, register based
+    instruction stream instead of the tree of closures that
+    `LambdaRealDoubleVisitor` builds.
+
+    The registers are laid out as the input symbols first, followed by the
+    constants (filled once in `init()`) and then the temporaries. While
+    compiling, identical subtrees (found using `Basic::hash()` and `__eq__`)
+    and identical instructions are emitted only once, and instructions whose
+    operands are all constants are folded away. Temporaries are reused as
+    soon as their last reader has executed, so the register file stays small.
+
+    Several expressions can be compiled together, in which case subtrees
+    shared between them (as in the entries of a Jacobian) are computed once.
+
+    Usage:
+
+        LambdaRealDoubleBytecode v;
+        v.init({x, y}, *expr);
+        double r = v.call({1.0, 2.0});
+
+        v.init({x, y}, {expr1, expr2});
+        double in[] = {1.0, 2.0}, out[2];
+        v.call(out, in);
+*/
+class LambdaRealDoubleBytecode {
+protected:
+    std::vector<BytecodeInstruction> code_;
+    //! Register file, the constants are stored here by `init()`
+    std::vector<double> regs_;
+    //! Register of each output
+    std::vector<unsigned> outputs_;
+    unsigned n_inputs_;
+    //! Register file of `call_batch()`, one block of points per register
+    std::vector<double> batch_regs_;
+
+    //! Compiles `b`, see `LambdaBytecodeCompiler::finalize()` for
+    //! `reuse_registers`
+    void compile(const vec_basic &x, const vec_basic &b, bool reuse_registers);
+public:
+    //! Number of points evaluated together by `call_batch()`
+    static const std::size_t batch_size = 128;
+
+    //! Compiles `b` as a function of the symbols `x`
+    void init(const vec_basic &x, const Basic &b);
+    //! Compiles all the expressions in `b` as functions of the symbols `x`
+    void init(const vec_basic &x, const vec_basic &b);
+    //! Compiles all the entries of `b` (in row-major order)
+    void init(const vec_basic &x, const DenseMatrix &b);
+
+    //! Evaluates the compiled expression at the point `vec`
+    double call(const std::vector<double> &vec);
+    //! Evaluates all the compiled expressions at `inputs`, the result of the
+    //! i-th expression is written to `outs[i]`
+    void call(double *outs, const double *inputs);
+
+    /*! Evaluates the compiled expression at `n` points given as a structure
+        of arrays: `inputs[i][k]` is the value of the i-th symbol at the k-th
+        point and the result is written to `out[k]`. Each instruction is
+        executed over a block of `batch_size` points at a time, which lets the
+        compiler vectorize the loops.
+    */
+    void call_batch(const double * const *inputs, double *out, std::size_t n);
+    //! Batch evaluation of all the compiled expressions, the result of the
+    //! i-th expression at the k-th point is written to `outs[i][k]`
+    void call_batch(const double * const *inputs, double * const *outs,
+            std::size_t n);
+
+    //! \return the instruction stream
+    inline const std::vector<BytecodeInstruction> &get_code() const {
+        return code_;
+    }
+    //! \return the number of registers used (inputs, constants, temporaries)
+    inline std::size_t get_num_registers() const { return regs_.size(); }
+    //! \return the number of compiled expressions
+    inline std::size_t get_num_outputs() const { return outputs_.size(); }
+};
+
+/*! Evaluates the numeric gradient of compiled expressions by reverse mode
+    automatic differentiation, without building symbolic derivatives.
+
+    The expressions are compiled like in `LambdaRealDoubleBytecode`, except
+    that every instruction keeps its own register. A call runs the bytecode
+    forward and then walks it backwards once, accumulating the adjoint of
+    every register, so the full gradient costs a small constant times one
+    evaluation whatever the number of symbols.
+
+        LambdaRealDoubleGradient g;
+        g.init({x, y}, *expr);
+        double in[] = {1.0, 2.0}, grad[2];
+        double value = g.call_gradient(in, grad);
+*/
+class LambdaRealDoubleGradient : public LambdaRealDoubleBytecode {
+protected:
+    //! Adjoint of each register
+    std::vector<double> adj_;
+public:
+    //! Compiles `b` as a function of the symbols `x`
+    void init(const vec_basic &x, const Basic &b);
+    //! Compiles all the expressions in `b` as functions of the symbols `x`
+    void init(const vec_basic &x, const vec_basic &b);
+
+    /*! Evaluates the `output`-th compiled expression at `inputs` and writes
+        its partial derivatives with respect to the symbols to `grad`.
+        \return the value of the expression
+    */
+    double call_gradient(const double *inputs, double *grad,
+            std::size_t output = 0);
+};
+
+} // SymEngine
+
+#endif
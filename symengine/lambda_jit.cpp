@@ -0,0 +1,98 @@
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+
+#include <symengine/lambda_jit.h>
+#include <symengine/printer.h>
+
+#ifdef HAVE_SYMENGINE_DLOPEN
+#    include <dlfcn.h>
+#    include <unistd.h>
+#endif
+
+namespace SymEngine {
+
+LambdaRealDoubleJIT::LambdaRealDoubleJIT()
+    : handle_{nullptr}, fn_{nullptr}
+{
+    const char *cc = std::getenv("SYMENGINE_CC");
+    compiler_ = cc ? cc : "cc -O2";
+}
+
+LambdaRealDoubleJIT::~LambdaRealDoubleJIT()
+{
+    close();
+}
+
+void LambdaRealDoubleJIT::close()
+{
+#ifdef HAVE_SYMENGINE_DLOPEN
+    if (handle_ != nullptr) dlclose(handle_);
+#endif
+    handle_ = nullptr;
+    fn_ = nullptr;
+}
+
+void LambdaRealDoubleJIT::init(const vec_basic &x, const Basic &b)
+{
+    init(x, vec_basic({b.rcp_from_this()}));
+}
+
+void LambdaRealDoubleJIT::init(const vec_basic &x, const vec_basic &b)
+{
+    close();
+    // The bytecode is always compiled, it reports unsupported expressions
+    // and undefined symbols the same way as the other Lambda classes.
+    fallback_.init(x, b);
+    outs_.resize(b.size());
+#ifdef HAVE_SYMENGINE_DLOPEN
+    std::string source;
+    try {
+        source = ccode_function("symengine_lambda", x, b);
+    } catch (std::runtime_error &) {
+        return;
+    }
+    const char *tmp = std::getenv("TMPDIR");
+    std::string tmpl = std::string(tmp ? tmp : "/tmp") + "/symengine_XXXXXX";
+    std::vector<char> dir(tmpl.begin(), tmpl.end());
+    dir.push_back('\0');
+    if (mkdtemp(dir.data()) == nullptr) return;
+    const std::string base(dir.data());
+    const std::string src = base + "/lambda.c", lib = base + "/lambda.so";
+    {
+        std::ofstream f(src);
+        f << source;
+    }
+    const std::string cmd = compiler_ + " -shared -fPIC -o \"" + lib + "\" \""
+        + src + "\" -lm > /dev/null 2>&1";
+    if (std::system(cmd.c_str()) == 0) {
+        handle_ = dlopen(lib.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (handle_ != nullptr) {
+            fn_ = reinterpret_cast<fn>(dlsym(handle_, "symengine_lambda"));
+            if (fn_ == nullptr) close();
+        }
+    }
+    // The library stays mapped after its file is removed
+    std::remove(src.c_str());
+    std::remove(lib.c_str());
+    rmdir(base.c_str());
+#endif
+}
+
+double LambdaRealDoubleJIT::call(const std::vector<double> &vec)
+{
+    if (fn_ == nullptr) return fallback_.call(vec);
+    fn_(outs_.data(), vec.data());
+    return outs_[0];
+}
+
+void LambdaRealDoubleJIT::call(double *outs, const double *inputs)
+{
+    if (fn_ == nullptr) {
+        fallback_.call(outs, inputs);
+    } else {
+        fn_(outs, inputs);
+    }
+}
+
+} // SymEngine
@@ -0,0 +1,64 @@
+/**
+ *  \file lambda_jit.h
+ *  Native evaluation of real double expressions through the system C compiler
+ *
+ **/
+#ifndef SYMENGINE_LAMBDA_JIT_H
+#define SYMENGINE_LAMBDA_JIT_H
+
+#include <symengine/lambda_bytecode.h>
+
+namespace SymEngine {
+
+/*! Evaluates expressions as machine code without depending on LLVM: the
+    expressions are printed as a C function (see `ccode_function()`), which
+    is compiled into a shared library by the system C compiler and loaded
+    with `dlopen()`.
+
+    The compiler command defaults to the `SYMENGINE_CC` environment variable,
+    or `cc -O2` if it is not set, and can be changed with `set_compiler()`.
+    If there is no compiler, the compilation fails or `dlopen()` is not
+    available on the platform, the expressions are evaluated by
+    `LambdaRealDoubleBytecode` instead; `is_native()` tells which path is
+    used.
+*/
+class LambdaRealDoubleJIT {
+protected:
+    typedef void (*fn)(double *out, const double *in);
+    LambdaRealDoubleBytecode fallback_;
+    std::string compiler_;
+    void *handle_;
+    fn fn_;
+    std::vector<double> outs_;
+
+    void close();
+public:
+    LambdaRealDoubleJIT();
+    ~LambdaRealDoubleJIT();
+
+    //! The loaded library is owned by this instance
+    LambdaRealDoubleJIT(const LambdaRealDoubleJIT&) = delete;
+    LambdaRealDoubleJIT& operator=(const LambdaRealDoubleJIT&) = delete;
+
+    //! Sets the command used to compile, e.g. `gcc -O3 -march=native`
+    inline void set_compiler(const std::string &compiler) {
+        compiler_ = compiler;
+    }
+
+    //! Compiles `b` as a function of the symbols `x`
+    void init(const vec_basic &x, const Basic &b);
+    //! Compiles all the expressions in `b` as functions of the symbols `x`
+    void init(const vec_basic &x, const vec_basic &b);
+
+    //! Evaluates the first compiled expression at the point `vec`
+    double call(const std::vector<double> &vec);
+    //! Evaluates all the compiled expressions at `inputs` into `outs`
+    void call(double *outs, const double *inputs);
+
+    //! \return true if the expressions run as native code
+    inline bool is_native() const { return fn_ != nullptr; }
+};
+
+} // SymEngine
+
+#endif
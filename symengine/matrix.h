@@ -85,6 +85,9 @@ public:
     virtual unsigned nrows() const { return row_; }
     virtual unsigned ncols() const { return col_; }
 
+    // If all the entries are Integers, Rationals or RealDoubles, the rank,
+    // determinant, inverse and solutions of linear systems are computed in
+    // the numeric matrices of numeric_matrix.h. Only these have a rank.
     virtual unsigned rank() const;
     virtual RCP<const Basic> det() const;
     virtual void inv(MatrixBase &result) const;
@@ -130,6 +133,10 @@ public:
     friend void jacobian(const DenseMatrix &A, const DenseMatrix &x,
             DenseMatrix &result);
 
+    // Return the Hessian of an expression
+    friend void hessian(const RCP<const Basic> &f, const DenseMatrix &x,
+            DenseMatrix &result);
+
     // Friend functions related to Matrix Operations
     friend void add_dense_dense(const DenseMatrix &A, const DenseMatrix &B,
         DenseMatrix &C);
@@ -175,6 +182,10 @@ public:
         const DenseMatrix &b, DenseMatrix &x);
     friend void fraction_free_gauss_jordan_solve(const DenseMatrix &A,
         const DenseMatrix &b, DenseMatrix &x);
+    friend void fraction_free_LU_solve(const DenseMatrix &A,
+        const DenseMatrix &b, DenseMatrix &x);
+    friend void LU_solve(const DenseMatrix &A, const DenseMatrix &b,
+        DenseMatrix &x);
 
     // Matrix Decomposition
     friend void fraction_free_LU(const DenseMatrix &A, DenseMatrix &LU);
@@ -212,6 +223,8 @@ private:
 };
 
 // ----------------------------- Sparse Matrices -----------------------------//
+class CSRSymbolicLU;
+
 class CSRMatrix: public MatrixBase {
 public:
     CSRMatrix();
@@ -308,6 +321,15 @@ public:
         CSRMatrix& C,
         RCP<const Basic> (&bin_op)(const RCP<const Basic>&, const RCP<const Basic>&));
 
+    // Sparse LU factorization
+    friend class CSRSymbolicLU;
+    friend void csr_LU(const CSRSymbolicLU &S, const CSRMatrix &A,
+        CSRMatrix &L, CSRMatrix &U);
+    friend void csr_LU_solve(const CSRSymbolicLU &S, const CSRMatrix &A,
+        const DenseMatrix &b, DenseMatrix &x);
+    friend RCP<const Basic> csr_det(const CSRSymbolicLU &S,
+        const CSRMatrix &A);
+
 private:
     std::vector<unsigned> p_;
     std::vector<unsigned> j_;
@@ -317,10 +339,58 @@ private:
     unsigned col_;
 };
 
+/*! Symbolic analysis of the sparse LU factorization of a square CSRMatrix.
+
+    It depends only on the sparsity pattern of the matrix `A`: a fill-reducing
+    permutation `P`, ordering the rows and columns by minimum degree on the
+    pattern of `A + A^T`, and the patterns of the factors of
+    `P*A*P^T = L*U`. The pivots are the diagonal entries of `P*A*P^T`, so one
+    analysis serves the numeric factorizations of every matrix with the
+    pattern of `A`, see `csr_LU()`.
+*/
+class CSRSymbolicLU {
+public:
+    CSRSymbolicLU() : n_{0} {}
+    //! Analyses the pattern of `A`; `P` is the identity if `order` is false
+    CSRSymbolicLU(const CSRMatrix &A, bool order = true);
+
+    //! \return true if `A` has the pattern this analysis was made for
+    bool matches(const CSRMatrix &A) const;
+
+    unsigned n_;
+    //! The pattern of the analysed matrix
+    std::vector<unsigned> ap_, aj_;
+    //! Row and column `k` of `P*A*P^T` are row and column `perm_[k]` of `A`,
+    //! and `iperm_` is the inverse permutation
+    std::vector<unsigned> perm_, iperm_;
+    //! The patterns of the rows of the strictly lower part of `L` and of `U`,
+    //! with sorted column indices; each row of `U` starts with its diagonal
+    std::vector<unsigned> lp_, lj_, up_, uj_;
+    //! Position of each entry of `A` in the entries of `U` followed by those
+    //! of `L`
+    std::vector<unsigned> map_;
+};
+
+// Sparse LU factorization P*A*P^T = L*U, with the analysis `S` of the pattern
+// of `A`. `L` has a unit diagonal.
+void csr_LU(const CSRSymbolicLU &S, const CSRMatrix &A, CSRMatrix &L,
+        CSRMatrix &U);
+
+// Solve A*x = b by the sparse LU factorization of `A` with the analysis `S`
+void csr_LU_solve(const CSRSymbolicLU &S, const CSRMatrix &A,
+        const DenseMatrix &b, DenseMatrix &x);
+
+// Determinant from the sparse LU factorization of `A` with the analysis `S`
+RCP<const Basic> csr_det(const CSRSymbolicLU &S, const CSRMatrix &A);
+
 // Return the Jacobian of the matrix
 void jacobian(const DenseMatrix &A, const DenseMatrix &x,
         DenseMatrix &result);
 
+// Return the Hessian of `f` with respect to the symbols in the column `x`
+void hessian(const RCP<const Basic> &f, const DenseMatrix &x,
+        DenseMatrix &result);
+
 // Matrix Factorization
 void LU(const DenseMatrix &A, DenseMatrix &L, DenseMatrix &U);
 
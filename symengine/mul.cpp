@@ -6,6 +6,7 @@
 #include <symengine/complex.h>
 #include <symengine/functions.h>
 #include <symengine/constants.h>
+#include <symengine/visitor.h>
 
 namespace SymEngine {
 
@@ -121,7 +122,7 @@ RCP<const SymEngine::Basic> Mul::from_dict(const RCP<const Number> &coef, map_ba
                 }
             } else {
                 // For coef*x or coef*x**3 we simply return Mul:
-                return make_rcp<const Mul>(coef, std::move(d));
+                return intern(make_rcp<const Mul>(coef, std::move(d)));
             }
         }
         if (coef->is_one()) {
@@ -129,12 +130,12 @@ RCP<const SymEngine::Basic> Mul::from_dict(const RCP<const Number> &coef, map_ba
             if (eq(*p->second, *one)) {
                 return p->first;
             }
-            return make_rcp<const Pow>(p->first, p->second);
+            return intern(make_rcp<const Pow>(p->first, p->second));
         } else {
-            return make_rcp<const Mul>(coef, std::move(d));
+            return intern(make_rcp<const Mul>(coef, std::move(d)));
         }
     } else {
-        return make_rcp<const Mul>(coef, std::move(d));
+        return intern(make_rcp<const Mul>(coef, std::move(d)));
     }
 }
 
@@ -380,6 +381,65 @@ RCP<const Basic> mul(const RCP<const Basic> &a, const RCP<const Basic> &b)
     return Mul::from_dict(coef, std::move(d));
 }
 
+RCP<const Basic> mul(const vec_basic &a)
+{
+    MulBuilder b;
+    for (const auto &p: a)
+        b.mul_term(p);
+    return b.finish();
+}
+
+MulBuilder::MulBuilder() : coef_{one}
+{
+}
+
+MulBuilder::MulBuilder(RCP<const Basic> &&a) : coef_{one}
+{
+    // Take over the reference, so that a Mul whose dictionary was stolen
+    // is released here.
+    RCP<const Basic> t = std::move(a);
+    if (not is_a<Mul>(*t)) {
+        mul_term(t);
+        return;
+    }
+    const Mul &s = static_cast<const Mul &>(*t);
+    coef_ = s.coef_;
+#if !defined(WITH_SYMENGINE_THREAD_SAFE) and defined(WITH_SYMENGINE_RCP) \
+    and !defined(WITH_SYMENGINE_INTERN)
+    if (t->use_count() == 1) {
+        // Nobody else is using the Mul, so we can steal its dictionary
+        dict_ = std::move(const_cast<map_basic_basic &>(s.dict_));
+        return;
+    }
+#endif
+    dict_ = s.dict_;
+}
+
+void MulBuilder::mul_term(const RCP<const Basic> &term)
+{
+    if (is_a_Number(*term)) {
+        imulnum(outArg(coef_), rcp_static_cast<const Number>(term));
+    } else if (is_a<Mul>(*term)) {
+        const Mul &m = static_cast<const Mul &>(*term);
+        if (not m.coef_->is_one())
+            imulnum(outArg(coef_), m.coef_);
+        for (const auto &p: m.dict_)
+            Mul::dict_add_term_new(outArg(coef_), dict_, p.second, p.first);
+    } else {
+        RCP<const Basic> exp, t;
+        Mul::as_base_exp(term, outArg(exp), outArg(t));
+        Mul::dict_add_term_new(outArg(coef_), dict_, exp, t);
+    }
+}
+
+RCP<const Basic> MulBuilder::finish()
+{
+    RCP<const Basic> r = Mul::from_dict(coef_, std::move(dict_));
+    coef_ = one;
+    dict_.clear();
+    return r;
+}
+
 RCP<const Basic> div(const RCP<const Basic> &a, const RCP<const Basic> &b)
 {
     return mul(a, pow(b, minus_one));
@@ -448,36 +508,7 @@ void Mul::power_num(const Ptr<RCP<const Number>> &coef, map_basic_basic &d,
 
 RCP<const Basic> Mul::subs(const map_basic_basic &subs_dict) const
 {
-    RCP<const Mul> self = rcp_from_this_cast<const Mul>();
-    auto it = subs_dict.find(self);
-    if (it != subs_dict.end())
-        return it->second;
-
-    RCP<const Number> coef = coef_;
-    map_basic_basic d;
-    for (const auto &p: dict_) {
-        RCP<const Basic> factor_old = Mul::from_dict(one, {{p.first, p.second}});
-        RCP<const Basic> factor = factor_old->subs(subs_dict);
-        if (factor == factor_old) {
-            Mul::dict_add_term_new(outArg(coef), d, p.second, p.first);
-        } else if (is_a_Number(*factor)) {
-            if (rcp_static_cast<const Number>(factor)->is_zero()) {
-                return factor;
-            }
-            imulnum(outArg(coef), rcp_static_cast<const Number>(factor));
-        } else if (is_a<Mul>(*factor)) {
-            RCP<const Mul> tmp = rcp_static_cast<const Mul>(factor);
-            imulnum(outArg(coef), tmp->coef_);
-            for (const auto &q: tmp->dict_) {
-                Mul::dict_add_term_new(outArg(coef), d, q.second, q.first);
-            }
-        } else {
-            RCP<const Basic> exp, t;
-            Mul::as_base_exp(factor, outArg(exp), outArg(t));
-            Mul::dict_add_term_new(outArg(coef), d, exp, t);
-        }
-    }
-    return Mul::from_dict(coef, std::move(d));
+    return SubsVisitor(subs_dict).apply(rcp_from_this());
 }
 
 vec_basic Mul::get_args() const {
@@ -489,4 +520,12 @@ vec_basic Mul::get_args() const {
     return args;
 }
 
+void Mul::for_each_arg(const ArgFunction &f) const {
+    if (not coef_->is_one()) f(*coef_);
+    for (const auto &p: dict_) {
+        f(*p.first);
+        f(*p.second);
+    }
+}
+
 } // SymEngine
@@ -59,10 +59,34 @@ public:
     virtual RCP<const Basic> subs(const map_basic_basic &subs_dict) const;
 
     virtual vec_basic get_args() const;
+    virtual void for_each_arg(const ArgFunction &f) const;
+};
+
+/*! Accumulates a product in a mutable dictionary, which is canonicalized
+    only once by `finish()`. It is the counterpart of AddBuilder for `mul()`.
+*/
+class MulBuilder {
+private:
+    RCP<const Number> coef_;
+    map_basic_basic dict_;
+public:
+    //! Starts with the product `1`
+    MulBuilder();
+    /*! Starts with the product `a`. If `a` is a Mul and this is its only
+        reference, its dictionary is moved into the builder instead of
+        copied. `a` is null afterwards.
+    */
+    explicit MulBuilder(RCP<const Basic> &&a);
+    //! Multiplies the product by `term`
+    void mul_term(const RCP<const Basic> &term);
+    //! \return the canonical product, the builder starts again from `1`
+    RCP<const Basic> finish();
 };
 //! Multiplication
 RCP<const Basic> mul(const RCP<const Basic> &a,
         const RCP<const Basic> &b);
+//! \return the product of all the elements of `a`
+RCP<const Basic> mul(const vec_basic &a);
 //! Division
 RCP<const Basic> div(const RCP<const Basic> &a,
         const RCP<const Basic> &b);
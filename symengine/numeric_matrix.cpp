@@ -0,0 +1,550 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include <symengine/numeric_matrix.h>
+#include <symengine/integer.h>
+#include <symengine/rational.h>
+#include <symengine/real_double.h>
+#include <symengine/ntheory.h>
+
+namespace SymEngine {
+
+// ---------------------------- Conversions ----------------------------------//
+
+NumericDomain numeric_domain(const vec_basic &m)
+{
+    NumericDomain d = NumericDomain::integer;
+    for (const auto &e: m) {
+        if (is_a<Integer>(*e)) {
+            continue;
+        } else if (is_a<Rational>(*e)) {
+            if (d == NumericDomain::integer)
+                d = NumericDomain::rational;
+        } else if (is_a<RealDouble>(*e)) {
+            d = NumericDomain::real_double;
+        } else {
+            return NumericDomain::none;
+        }
+    }
+    return d;
+}
+
+NumericDomain numeric_domain(NumericDomain a, NumericDomain b)
+{
+    return a < b ? b : a;
+}
+
+void to_numeric(const vec_basic &m, unsigned row, unsigned col,
+        IntegerDenseMatrix &A)
+{
+    SYMENGINE_ASSERT(m.size() == std::size_t(row) * col)
+    A = IntegerDenseMatrix(row, col);
+    for (std::size_t i = 0; i < m.size(); i++)
+        A.m_[i] = static_cast<const Integer &>(*m[i]).i;
+}
+
+void to_numeric(const vec_basic &m, unsigned row, unsigned col,
+        RationalDenseMatrix &A)
+{
+    SYMENGINE_ASSERT(m.size() == std::size_t(row) * col)
+    A = RationalDenseMatrix(row, col);
+    for (std::size_t i = 0; i < m.size(); i++) {
+        if (is_a<Integer>(*m[i]))
+            A.m_[i] = static_cast<const Integer &>(*m[i]).i;
+        else
+            A.m_[i] = static_cast<const Rational &>(*m[i]).i;
+    }
+}
+
+void to_numeric(const vec_basic &m, unsigned row, unsigned col,
+        DoubleDenseMatrix &A)
+{
+    SYMENGINE_ASSERT(m.size() == std::size_t(row) * col)
+    A = DoubleDenseMatrix(row, col);
+    for (std::size_t i = 0; i < m.size(); i++) {
+        if (is_a<Integer>(*m[i]))
+            A.m_[i] = static_cast<const Integer &>(*m[i]).i.get_d();
+        else if (is_a<Rational>(*m[i]))
+            A.m_[i] = static_cast<const Rational &>(*m[i]).i.get_d();
+        else
+            A.m_[i] = static_cast<const RealDouble &>(*m[i]).i;
+    }
+}
+
+void from_numeric(const IntegerDenseMatrix &A, vec_basic &m)
+{
+    m.resize(A.m_.size());
+    for (std::size_t i = 0; i < m.size(); i++)
+        m[i] = integer(A.m_[i]);
+}
+
+void from_numeric(const RationalDenseMatrix &A, vec_basic &m)
+{
+    m.resize(A.m_.size());
+    for (std::size_t i = 0; i < m.size(); i++)
+        m[i] = Rational::from_mpq(A.m_[i]);
+}
+
+void from_numeric(const DoubleDenseMatrix &A, vec_basic &m)
+{
+    m.resize(A.m_.size());
+    for (std::size_t i = 0; i < m.size(); i++)
+        m[i] = real_double(A.m_[i]);
+}
+
+/*! Stores in row `i` of `B` the row `i` of `A` followed by the row `i` of
+    `C`, both multiplied by the least common multiple of the denominators of
+    the row, so that `B` is an integer matrix.
+    \return the product of the multipliers of the rows
+*/
+static mpz_class clear_denominators(const RationalDenseMatrix &A,
+        const RationalDenseMatrix &C, IntegerDenseMatrix &B)
+{
+    SYMENGINE_ASSERT(C.col_ == 0 or C.row_ == A.row_)
+    B = IntegerDenseMatrix(A.row_, A.col_ + C.col_);
+    mpz_class scale = 1, l;
+    for (unsigned i = 0; i < A.row_; i++) {
+        l = 1;
+        for (unsigned j = 0; j < A.col_; j++)
+            mpz_lcm(l.get_mpz_t(), l.get_mpz_t(), A(i, j).get_den_mpz_t());
+        for (unsigned j = 0; j < C.col_; j++)
+            mpz_lcm(l.get_mpz_t(), l.get_mpz_t(), C(i, j).get_den_mpz_t());
+        mpz_class *b = B.row(i);
+        for (unsigned j = 0; j < A.col_; j++)
+            b[j] = A(i, j).get_num() * (l / A(i, j).get_den());
+        for (unsigned j = 0; j < C.col_; j++)
+            b[A.col_ + j] = C(i, j).get_num() * (l / C(i, j).get_den());
+        scale *= l;
+    }
+    return scale;
+}
+
+// ------------------------- Integer Elimination -----------------------------//
+
+unsigned fraction_free_echelon(IntegerDenseMatrix &A, unsigned ncols,
+        int &sign)
+{
+    SYMENGINE_ASSERT(ncols <= A.col_)
+    unsigned rows = A.row_, cols = A.col_, r = 0;
+    mpz_class prev = 1, t;
+    sign = 1;
+    for (unsigned c = 0; c < ncols and r < rows; c++) {
+        unsigned p = r;
+        while (p < rows and A(p, c) == 0)
+            p++;
+        if (p == rows)
+            continue;
+        if (p != r) {
+            std::swap_ranges(A.row(p), A.row(p) + cols, A.row(r));
+            sign = -sign;
+        }
+        const mpz_class *pr = A.row(r);
+        bool divide = (prev != 1);
+        // Every row below becomes `(pr[c]*ri - ri[c]*pr) / prev`, which is
+        // exact by Sylvester's identity
+        for (unsigned i = r + 1; i < rows; i++) {
+            mpz_class *ri = A.row(i);
+            bool eliminate = (ri[c] != 0);
+            for (unsigned j = c + 1; j < cols; j++) {
+                mpz_mul(t.get_mpz_t(), pr[c].get_mpz_t(), ri[j].get_mpz_t());
+                if (eliminate)
+                    mpz_submul(t.get_mpz_t(), ri[c].get_mpz_t(),
+                        pr[j].get_mpz_t());
+                if (divide)
+                    mpz_divexact(ri[j].get_mpz_t(), t.get_mpz_t(),
+                        prev.get_mpz_t());
+                else
+                    mpz_swap(ri[j].get_mpz_t(), t.get_mpz_t());
+            }
+            ri[c] = 0;
+        }
+        prev = pr[c];
+        r++;
+    }
+    return r;
+}
+
+//! \return the determinant of `A` from its fraction free echelon form `B`
+//! of rank `r`
+static mpz_class echelon_det(const IntegerDenseMatrix &B, unsigned r, int sign)
+{
+    unsigned n = B.row_;
+    if (n == 0)
+        return 1;
+    if (r < n)
+        return 0;
+    return sign == 1 ? B(n - 1, n - 1) : mpz_class(-B(n - 1, n - 1));
+}
+
+mpz_class det_fraction_free(const IntegerDenseMatrix &A)
+{
+    SYMENGINE_ASSERT(A.row_ == A.col_)
+    IntegerDenseMatrix B = A;
+    int sign;
+    unsigned r = fraction_free_echelon(B, B.col_, sign);
+    return echelon_det(B, r, sign);
+}
+
+// ------------------------- Modular Determinant -----------------------------//
+
+//! The moduli of `det_modular()` are primes below this bound, so that the
+//! product of two residues is exact in a double
+static const unsigned modular_prime_bound = 1u << 26;
+
+//! Appends to `primes` the `count` largest primes below
+//! `modular_prime_bound`, sieving windows below it with the small primes
+static void modular_primes(unsigned count, std::vector<unsigned> &primes)
+{
+    std::vector<unsigned> small;
+    Sieve::generate_primes(small, 1u << 13);
+    const unsigned window = 1u << 12;
+    std::vector<bool> composite(window);
+    for (unsigned hi = modular_prime_bound; primes.size() < count;
+            hi -= window) {
+        unsigned lo = hi - window;
+        std::fill(composite.begin(), composite.end(), false);
+        for (unsigned q: small)
+            for (unsigned m = (lo + q - 1) / q * q; m < hi; m += q)
+                composite[m - lo] = true;
+        for (unsigned m = hi; m-- > lo and primes.size() < count;)
+            if (not composite[m - lo])
+                primes.push_back(m);
+    }
+}
+
+//! \return the inverse of `a` modulo the prime `p`, `a` is not divisible by
+//! `p`
+static std::uint64_t inverse_mod(std::uint64_t a, std::uint64_t p)
+{
+    std::int64_t r0 = p, r1 = a, s0 = 0, s1 = 1;
+    while (r1 != 0) {
+        std::int64_t q = r0 / r1, t;
+        t = r0 - q * r1; r0 = r1; r1 = t;
+        t = s0 - q * s1; s0 = s1; s1 = t;
+    }
+    return s0 < 0 ? s0 + p : s0;
+}
+
+/*! \return `det(A) mod p` by Gaussian elimination modulo the prime `p`,
+    using `M` as the work space.
+
+    The residues are kept in doubles: a residue plus the product of two is
+    below `2**53`, so the updates of the rows are exact and their remainders
+    are found with a multiplication by `1/p` and at most one correction,
+    which vectorizes. The products of two residues are taken in 64 bits, as
+    they do not fit a `long` where it has 32.
+*/
+static std::uint64_t det_mod(const IntegerDenseMatrix &A, std::uint64_t p,
+        std::vector<double> &M)
+{
+    unsigned n = A.row_;
+    M.resize(A.m_.size());
+    for (std::size_t i = 0; i < M.size(); i++)
+        M[i] = double(mpz_fdiv_ui(A.m_[i].get_mpz_t(),
+            static_cast<unsigned long>(p)));
+    const double dp = double(p), pinv = 1.0 / dp;
+    std::uint64_t det = 1;
+    for (unsigned k = 0; k < n; k++) {
+        unsigned r = k;
+        while (r < n and M[std::size_t(r) * n + k] == 0.0)
+            r++;
+        if (r == n)
+            return 0;
+        double *rk = &M[std::size_t(k) * n];
+        if (r != k) {
+            std::swap_ranges(rk, rk + n, &M[std::size_t(r) * n]);
+            det = p - det;
+        }
+        std::uint64_t pivot = static_cast<std::uint64_t>(rk[k]);
+        det = det * pivot % p;
+        std::uint64_t inv = inverse_mod(pivot, p);
+        for (unsigned i = k + 1; i < n; i++) {
+            double *ri = &M[std::size_t(i) * n];
+            std::uint64_t f = static_cast<std::uint64_t>(ri[k]) * inv % p;
+            if (f == 0)
+                continue;
+            // Adds `-f` times row `k` to row `i`
+            const double g = double(p - f);
+            for (unsigned j = k + 1; j < n; j++) {
+                double t = ri[j] + g * rk[j];
+                t -= std::floor(t * pinv) * dp;
+                t = t < 0.0 ? t + dp : t;
+                ri[j] = t >= dp ? t - dp : t;
+            }
+        }
+    }
+    return det;
+}
+
+mpz_class det_modular(const IntegerDenseMatrix &A)
+{
+    SYMENGINE_ASSERT(A.row_ == A.col_)
+    unsigned n = A.row_;
+    if (n == 0)
+        return 1;
+    // log2 of Hadamard's bound: |det(A)| <= prod_i |row i|
+    double bits = 0.0;
+    mpz_class sq;
+    for (unsigned i = 0; i < n; i++) {
+        sq = 0;
+        for (unsigned j = 0; j < n; j++)
+            mpz_addmul(sq.get_mpz_t(), A(i, j).get_mpz_t(),
+                A(i, j).get_mpz_t());
+        if (sq == 0)
+            return 0;
+        long e;
+        double m = mpz_get_d_2exp(&e, sq.get_mpz_t());
+        bits += 0.5 * (e + std::log2(m));
+    }
+    // The residues determine det(A) in (-M/2, M/2] once the product M of
+    // the primes exceeds twice the bound, every prime has more than 25 bits
+    // and one more bit covers the rounding of `bits`
+    unsigned count = static_cast<unsigned>(std::ceil((bits + 2.0) / 25.0));
+    std::vector<unsigned> primes;
+    modular_primes(count, primes);
+
+    std::vector<RCP<const Integer>> rem, mod;
+    std::vector<double> work;
+    for (unsigned p: primes) {
+        rem.push_back(integer(det_mod(A, p, work)));
+        mod.push_back(integer(p));
+    }
+    RCP<const Integer> r;
+    crt(outArg(r), rem, mod);
+    mpz_class d = r->as_mpz(), m = 1;
+    for (unsigned p: primes)
+        m *= p;
+    if (2 * d > m)
+        d -= m;
+    return d;
+}
+
+//! Size of the integer matrices from which `det_modular()` is faster than
+//! `det_fraction_free()`
+static const unsigned det_modular_threshold = 24;
+
+mpz_class det_numeric(const IntegerDenseMatrix &A)
+{
+    SYMENGINE_ASSERT(A.row_ == A.col_)
+    if (A.row_ < det_modular_threshold)
+        return det_fraction_free(A);
+    return det_modular(A);
+}
+
+mpq_class det_numeric(const RationalDenseMatrix &A)
+{
+    SYMENGINE_ASSERT(A.row_ == A.col_)
+    IntegerDenseMatrix B;
+    mpz_class scale = clear_denominators(A, RationalDenseMatrix(), B);
+    mpq_class d(det_numeric(B), scale);
+    d.canonicalize();
+    return d;
+}
+
+unsigned rank_numeric(const IntegerDenseMatrix &A)
+{
+    IntegerDenseMatrix B = A;
+    int sign;
+    return fraction_free_echelon(B, B.col_, sign);
+}
+
+unsigned rank_numeric(const RationalDenseMatrix &A)
+{
+    IntegerDenseMatrix B;
+    clear_denominators(A, RationalDenseMatrix(), B);
+    int sign;
+    return fraction_free_echelon(B, B.col_, sign);
+}
+
+/*! Solves the system with the augmented matrix `M = [A | B]`, where `A` is
+    `n` by `n`, overwriting `M`.
+
+    After the elimination `M = [U | C]` with `U` upper triangular and
+    `D = U[n-1][n-1] = +-det(A)`, and `Y = D*X` is an integer matrix (by
+    Cramer's rule), so the back substitution runs on integers as well, with
+    exact divisions by the pivots.
+*/
+static bool solve_augmented(IntegerDenseMatrix &M, unsigned n,
+        RationalDenseMatrix &X)
+{
+    SYMENGINE_ASSERT(M.row_ == n and M.col_ >= n)
+    unsigned k = M.col_ - n;
+    int sign;
+    if (fraction_free_echelon(M, n, sign) < n)
+        return false;
+    X = RationalDenseMatrix(n, k);
+    if (n == 0)
+        return true;
+    const mpz_class &D = M(n - 1, n - 1);
+    IntegerDenseMatrix Y(n, k);
+    for (unsigned i = n; i-- > 0;) {
+        const mpz_class *u = M.row(i);
+        mpz_class *y = Y.row(i);
+        for (unsigned q = 0; q < k; q++)
+            mpz_mul(y[q].get_mpz_t(), D.get_mpz_t(), u[n + q].get_mpz_t());
+        for (unsigned j = i + 1; j < n; j++) {
+            if (u[j] == 0)
+                continue;
+            const mpz_class *yj = Y.row(j);
+            for (unsigned q = 0; q < k; q++)
+                mpz_submul(y[q].get_mpz_t(), u[j].get_mpz_t(),
+                    yj[q].get_mpz_t());
+        }
+        for (unsigned q = 0; q < k; q++)
+            mpz_divexact(y[q].get_mpz_t(), y[q].get_mpz_t(),
+                u[i].get_mpz_t());
+    }
+    for (std::size_t i = 0; i < X.m_.size(); i++) {
+        mpq_class &x = X.m_[i];
+        mpz_swap(x.get_num_mpz_t(), Y.m_[i].get_mpz_t());
+        x.get_den() = D;
+        x.canonicalize();
+    }
+    return true;
+}
+
+bool solve_numeric(const IntegerDenseMatrix &A, const IntegerDenseMatrix &B,
+        RationalDenseMatrix &X)
+{
+    SYMENGINE_ASSERT(A.row_ == A.col_ and B.row_ == A.row_)
+    unsigned n = A.row_;
+    IntegerDenseMatrix M(n, n + B.col_);
+    for (unsigned i = 0; i < n; i++) {
+        std::copy(A.row(i), A.row(i) + n, M.row(i));
+        std::copy(B.row(i), B.row(i) + B.col_, M.row(i) + n);
+    }
+    return solve_augmented(M, n, X);
+}
+
+bool solve_numeric(const RationalDenseMatrix &A, const RationalDenseMatrix &B,
+        RationalDenseMatrix &X)
+{
+    SYMENGINE_ASSERT(A.row_ == A.col_ and B.row_ == A.row_)
+    // Scaling a row of the system does not change its solution
+    IntegerDenseMatrix M;
+    clear_denominators(A, B, M);
+    return solve_augmented(M, A.row_, X);
+}
+
+// ------------------------- Double Elimination ------------------------------//
+
+/*! LU decomposition with partial pivoting in place: `A` becomes the unit
+    lower triangular `L` below its diagonal and `U` on and above it, with
+    the rows exchanged as recorded in `perm`.
+    \return false if a pivot is zero
+*/
+static bool lu_decompose(DoubleDenseMatrix &A, std::vector<unsigned> &perm,
+        int &sign)
+{
+    unsigned n = A.row_;
+    perm.resize(n);
+    for (unsigned i = 0; i < n; i++)
+        perm[i] = i;
+    sign = 1;
+    for (unsigned k = 0; k < n; k++) {
+        unsigned p = k;
+        for (unsigned i = k + 1; i < n; i++)
+            if (std::fabs(A(i, k)) > std::fabs(A(p, k)))
+                p = i;
+        if (A(p, k) == 0.0)
+            return false;
+        if (p != k) {
+            std::swap_ranges(A.row(p), A.row(p) + n, A.row(k));
+            std::swap(perm[p], perm[k]);
+            sign = -sign;
+        }
+        const double *rk = A.row(k);
+        for (unsigned i = k + 1; i < n; i++) {
+            double *ri = A.row(i);
+            double l = ri[k] /= rk[k];
+            for (unsigned j = k + 1; j < n; j++)
+                ri[j] -= l * rk[j];
+        }
+    }
+    return true;
+}
+
+double det_numeric(const DoubleDenseMatrix &A)
+{
+    SYMENGINE_ASSERT(A.row_ == A.col_)
+    DoubleDenseMatrix B = A;
+    std::vector<unsigned> perm;
+    int sign;
+    if (not lu_decompose(B, perm, sign))
+        return 0.0;
+    double d = sign;
+    for (unsigned i = 0; i < B.row_; i++)
+        d *= B(i, i);
+    return d;
+}
+
+unsigned rank_numeric(const DoubleDenseMatrix &A)
+{
+    DoubleDenseMatrix B = A;
+    unsigned rows = B.row_, cols = B.col_, r = 0;
+    double max = 0.0;
+    for (double a: B.m_)
+        max = std::max(max, std::fabs(a));
+    double tol = std::max(rows, cols) * max
+        * std::numeric_limits<double>::epsilon();
+    for (unsigned c = 0; c < cols and r < rows; c++) {
+        unsigned p = r;
+        for (unsigned i = r + 1; i < rows; i++)
+            if (std::fabs(B(i, c)) > std::fabs(B(p, c)))
+                p = i;
+        if (std::fabs(B(p, c)) <= tol)
+            continue;
+        std::swap_ranges(B.row(p), B.row(p) + cols, B.row(r));
+        const double *pr = B.row(r);
+        for (unsigned i = r + 1; i < rows; i++) {
+            double *ri = B.row(i);
+            double l = ri[c] / pr[c];
+            for (unsigned j = c + 1; j < cols; j++)
+                ri[j] -= l * pr[j];
+        }
+        r++;
+    }
+    return r;
+}
+
+bool solve_numeric(const DoubleDenseMatrix &A, const DoubleDenseMatrix &B,
+        DoubleDenseMatrix &X)
+{
+    SYMENGINE_ASSERT(A.row_ == A.col_ and B.row_ == A.row_)
+    unsigned n = A.row_, k = B.col_;
+    DoubleDenseMatrix LU = A;
+    std::vector<unsigned> perm;
+    int sign;
+    if (not lu_decompose(LU, perm, sign))
+        return false;
+    X = DoubleDenseMatrix(n, k);
+    for (unsigned i = 0; i < n; i++)
+        std::copy(B.row(perm[i]), B.row(perm[i]) + k, X.row(i));
+    // Forward substitution with L, then back substitution with U, on whole
+    // rows of X
+    for (unsigned i = 0; i < n; i++) {
+        double *xi = X.row(i);
+        for (unsigned j = 0; j < i; j++) {
+            double l = LU(i, j);
+            const double *xj = X.row(j);
+            for (unsigned q = 0; q < k; q++)
+                xi[q] -= l * xj[q];
+        }
+    }
+    for (unsigned i = n; i-- > 0;) {
+        double *xi = X.row(i);
+        for (unsigned j = i + 1; j < n; j++) {
+            double u = LU(i, j);
+            const double *xj = X.row(j);
+            for (unsigned q = 0; q < k; q++)
+                xi[q] -= u * xj[q];
+        }
+        for (unsigned q = 0; q < k; q++)
+            xi[q] /= LU(i, i);
+    }
+    return true;
+}
+
+} // SymEngine
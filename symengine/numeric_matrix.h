@@ -0,0 +1,129 @@
+/**
+ *  \file numeric_matrix.h
+ *  Dense matrices of doubles, integers and rationals
+ *
+ **/
+#ifndef SYMENGINE_NUMERIC_MATRIX_H
+#define SYMENGINE_NUMERIC_MATRIX_H
+
+#include <symengine/basic.h>
+
+namespace SymEngine {
+
+/*! Dense matrix with entries of type `T`, one of `double`, `mpz_class` and
+    `mpq_class`, stored contiguously in row-major order.
+
+    The kernels below work on the entries in place, without creating any
+    Basic. DenseMatrix converts to these matrices when all its entries are
+    numbers, see `numeric_domain()`.
+*/
+template <typename T>
+class NumericDenseMatrix {
+public:
+    std::vector<T> m_;
+    unsigned row_;
+    unsigned col_;
+
+    NumericDenseMatrix() : row_{0}, col_{0} {}
+    NumericDenseMatrix(unsigned row, unsigned col)
+        : m_(std::size_t(row) * col), row_{row}, col_{col} {}
+
+    inline T &operator()(unsigned i, unsigned j) {
+        return m_[std::size_t(i) * col_ + j];
+    }
+    inline const T &operator()(unsigned i, unsigned j) const {
+        return m_[std::size_t(i) * col_ + j];
+    }
+    //! \return the first entry of row `i`
+    inline T *row(unsigned i) {
+        return &m_[std::size_t(i) * col_];
+    }
+    inline const T *row(unsigned i) const {
+        return &m_[std::size_t(i) * col_];
+    }
+};
+
+typedef NumericDenseMatrix<double> DoubleDenseMatrix;
+typedef NumericDenseMatrix<mpz_class> IntegerDenseMatrix;
+typedef NumericDenseMatrix<mpq_class> RationalDenseMatrix;
+
+//! The narrowest of the numeric matrices holding a set of entries
+enum class NumericDomain {
+    //! All the entries are Integers
+    integer,
+    //! All the entries are Integers or Rationals
+    rational,
+    //! All the entries are Integers, Rationals or RealDoubles, and at least
+    //! one of them is a RealDouble
+    real_double,
+    //! Some entry is not one of the above
+    none
+};
+
+//! \return the domain of the entries `m`
+NumericDomain numeric_domain(const vec_basic &m);
+//! \return the domain of the union of the entries `a` and `b`
+NumericDomain numeric_domain(NumericDomain a, NumericDomain b);
+
+//! Converts the `row` by `col` entries `m`, which must all lie in the domain
+//! of `A`, to `A`
+void to_numeric(const vec_basic &m, unsigned row, unsigned col,
+        IntegerDenseMatrix &A);
+void to_numeric(const vec_basic &m, unsigned row, unsigned col,
+        RationalDenseMatrix &A);
+void to_numeric(const vec_basic &m, unsigned row, unsigned col,
+        DoubleDenseMatrix &A);
+//! Converts the entries of `A` to Numbers in `m`
+void from_numeric(const IntegerDenseMatrix &A, vec_basic &m);
+void from_numeric(const RationalDenseMatrix &A, vec_basic &m);
+void from_numeric(const DoubleDenseMatrix &A, vec_basic &m);
+
+/*! Brings `A` to row echelon form by fraction free elimination (Bareiss'
+    algorithm) with row exchanges, using the first `ncols` columns as pivot
+    columns. Every entry stays an integer, and the pivot of the `k`-th
+    nonzero row is a minor of order `k + 1` of `A`.
+    \return the rank of the first `ncols` columns, and the sign of the row
+    permutation in `sign`
+*/
+unsigned fraction_free_echelon(IntegerDenseMatrix &A, unsigned ncols,
+        int &sign);
+
+//! \return the determinant of `A` from its fraction free echelon form
+mpz_class det_fraction_free(const IntegerDenseMatrix &A);
+/*! \return the determinant of `A` from its residues modulo word size
+    primes, reconstructed by the Chinese remainder theorem. Enough primes
+    are taken for their product to exceed twice Hadamard's bound on the
+    determinant.
+*/
+mpz_class det_modular(const IntegerDenseMatrix &A);
+
+/*! \return the determinant of the square matrix `A`. Integer matrices use
+    `det_modular()` from 24 rows on, where it overtakes
+    `det_fraction_free()`, and rational ones are scaled to integer ones.
+*/
+mpz_class det_numeric(const IntegerDenseMatrix &A);
+mpq_class det_numeric(const RationalDenseMatrix &A);
+//! Uses LU decomposition with partial pivoting
+double det_numeric(const DoubleDenseMatrix &A);
+
+//! \return the rank of `A`
+unsigned rank_numeric(const IntegerDenseMatrix &A);
+unsigned rank_numeric(const RationalDenseMatrix &A);
+//! Entries below a tolerance relative to the largest entry count as zero
+unsigned rank_numeric(const DoubleDenseMatrix &A);
+
+/*! Solves `A*X = B` for the square matrix `A`. The integer and rational
+    systems are solved exactly by fraction free elimination, the double ones
+    by LU decomposition with partial pivoting.
+    \return false if `A` is singular, in which case `X` is unspecified
+*/
+bool solve_numeric(const IntegerDenseMatrix &A, const IntegerDenseMatrix &B,
+        RationalDenseMatrix &X);
+bool solve_numeric(const RationalDenseMatrix &A, const RationalDenseMatrix &B,
+        RationalDenseMatrix &X);
+bool solve_numeric(const DoubleDenseMatrix &A, const DoubleDenseMatrix &B,
+        DoubleDenseMatrix &X);
+
+} // SymEngine
+
+#endif
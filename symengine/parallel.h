@@ -0,0 +1,84 @@
+/**
+ *  \file parallel.h
+ *  Loops split over the OpenMP threads
+ *
+ **/
+#ifndef SYMENGINE_PARALLEL_H
+#define SYMENGINE_PARALLEL_H
+
+#include <symengine/symengine_rcp.h>
+
+// The threads copy and release RCPs of the expressions they share, which
+// needs thread safe reference counts (never those of Teuchos::RCP)
+#if defined(WITH_OPENMP) and defined(SYMENGINE_RCP_THREAD_SAFE)
+#    define SYMENGINE_PARALLEL
+#endif
+
+#if defined(SYMENGINE_PARALLEL)
+#include <cstddef>
+#include <exception>
+#include <vector>
+#include <omp.h>
+
+namespace SymEngine {
+
+//! \return true if a loop can be split over more than one thread here
+inline bool parallel_available()
+{
+    return omp_get_max_threads() > 1 and not omp_in_parallel();
+}
+
+//! \return the number of threads `parallel_for()` uses
+inline unsigned parallel_threads()
+{
+    return omp_get_max_threads();
+}
+
+//! How `parallel_for()` deals the iterations out to the threads
+enum class ParallelSchedule {
+    //! One by one in turn, so that each thread gets the same ones every time
+    round_robin,
+    //! To the next idle thread, for iterations of uneven cost
+    dynamic
+};
+
+/*! Calls `f(t, i)` for all `i` in `[0, n)` from `parallel_threads()` OpenMP
+    threads, `t` being the number of the calling thread. Exceptions must not
+    leave the parallel region: once one is thrown the thread skips its
+    remaining iterations, and the first one (by thread number) is rethrown
+    after all threads are done.
+*/
+template <typename F>
+void parallel_for(std::size_t n, ParallelSchedule schedule, F f)
+{
+    std::vector<std::exception_ptr> errors(parallel_threads());
+    #pragma omp parallel num_threads(errors.size())
+    {
+        std::size_t t = omp_get_thread_num();
+        auto call = [&](long i) {
+            if (errors[t]) return;
+            try {
+                f(t, static_cast<std::size_t>(i));
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        };
+        if (schedule == ParallelSchedule::dynamic) {
+            #pragma omp for schedule(dynamic)
+            for (long i = 0; i < static_cast<long>(n); i++)
+                call(i);
+        } else {
+            #pragma omp for schedule(static, 1)
+            for (long i = 0; i < static_cast<long>(n); i++)
+                call(i);
+        }
+    }
+    for (auto &e: errors)
+        if (e) std::rethrow_exception(e);
+}
+
+} // SymEngine
+
+#endif // SYMENGINE_PARALLEL
+
+#endif
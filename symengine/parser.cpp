@@ -111,16 +111,24 @@ class ExpressionParser {
 
                 // continue the parsing after operator_end[iter], as we have already parsed till there
                 // using the recursive call to parse_string
+                // the builders reuse the dictionary of 'result', so that
+                // long sums and products are not quadratic to parse
                 if (s[iter] == '+') {
-                    result = add(result, parse_string(iter+1, operator_end[iter]));
+                    AddBuilder b(std::move(result));
+                    b.add_term(parse_string(iter+1, operator_end[iter]));
+                    result = b.finish();
                     iter = operator_end[iter]-1;
 
                 } else if (s[iter] == '*') {
-                    result = mul(result, parse_string(iter+1, operator_end[iter]));
+                    MulBuilder b(std::move(result));
+                    b.mul_term(parse_string(iter+1, operator_end[iter]));
+                    result = b.finish();
                     iter = operator_end[iter]-1;
 
                 } else if (s[iter] == '-') {
-                    result = sub(result, parse_string(iter+1, operator_end[iter]));
+                    AddBuilder b(std::move(result));
+                    b.add_term(mul(minus_one, parse_string(iter+1, operator_end[iter])));
+                    result = b.finish();
                     iter = operator_end[iter]-1;
 
                 } else if (s[iter] == '/') {
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <limits>
+
 #include <symengine/polynomial.h>
 #include <symengine/add.h>
 #include <symengine/mul.h>
@@ -36,15 +39,14 @@ bool UnivariatePolynomial::is_canonical(const unsigned int &degree_, const map_u
 
 std::size_t UnivariatePolynomial::__hash__() const
 {
-    std::hash<std::string> hash_string;
     std::size_t seed = UNIVARIATEPOLYNOMIAL;
 
-    seed += hash_string(this->var_->get_name());
+    seed += stable_hash<std::string>(this->var_->get_name());
     for (const auto &it : this->dict_)
     {
         std::size_t temp = UNIVARIATEPOLYNOMIAL;
         hash_combine<unsigned int>(temp, it.first);
-        hash_combine<long long int>(temp, it.second.get_si());
+        hash_combine<long long int>(temp, mpz_hash_bits(it.second.get_mpz_t()));
         seed += temp;
     }
     return seed;
@@ -134,14 +136,122 @@ mpz_class UnivariatePolynomial::eval(const mpz_class &x) const {
     return ans;
 }
 
+//! \return the `GMP_NUMB_BITS` bits of `|x|` starting at bit `pos`
+static inline mp_limb_t limb_at(mpz_srcptr x, std::size_t pos)
+{
+    mp_size_t q = pos / GMP_NUMB_BITS;
+    unsigned s = pos % GMP_NUMB_BITS;
+    mp_limb_t l = mpz_getlimbn(x, q) >> s;
+    if (s != 0) l |= mpz_getlimbn(x, q + 1) << (GMP_NUMB_BITS - s);
+    return l;
+}
+
+//! Adds `|c| * 2**offset` to the integer in the limbs `w` (least significant
+//! first), which must be long enough for the sum
+static void add_limbs(std::vector<mp_limb_t> &w, mpz_srcptr c,
+        std::size_t offset)
+{
+    static_assert(GMP_NAIL_BITS == 0, "GMP with nails is not supported");
+    std::size_t q = offset / GMP_NUMB_BITS;
+    unsigned s = offset % GMP_NUMB_BITS;
+    std::size_t n = mpz_size(c);
+    mp_limb_t prev = 0, carry = 0;
+    for (std::size_t k = 0; k <= n; k++) {
+        mp_limb_t l = k < n ? mpz_getlimbn(c, k) : 0;
+        mp_limb_t v = s == 0 ? l : (l << s) | (prev >> (GMP_NUMB_BITS - s));
+        prev = l;
+        mp_limb_t t = w[q + k] + v;
+        mp_limb_t overflow = t < v;
+        w[q + k] = t + carry;
+        carry = overflow | (w[q + k] < t);
+    }
+    for (std::size_t k = q + n + 1; carry != 0; k++)
+        carry = ++w[k] == 0;
+}
+
+//! Adds `c * 2**offset` to the sum of the positive terms in the limbs `pos`
+//! or of the negative ones in `neg`, which is allocated like `pos` if empty
+static void add_term(std::vector<mp_limb_t> &pos, std::vector<mp_limb_t> &neg,
+        const mpz_class &c, std::size_t offset)
+{
+    int s = sgn(c);
+    if (s == 0) return;
+    if (s < 0 and neg.empty()) neg.assign(pos.size(), 0);
+    add_limbs(s > 0 ? pos : neg, c.get_mpz_t(), offset);
+}
+
+//! Sets `r = pos - neg`, for the integers in the limbs `pos` and `neg`
+static void limbs_to_mpz(const std::vector<mp_limb_t> &pos,
+        const std::vector<mp_limb_t> &neg, mpz_class &r)
+{
+    mpz_import(r.get_mpz_t(), pos.size(), -1, sizeof(mp_limb_t), 0, 0,
+        pos.data());
+    if (not neg.empty()) {
+        mpz_class t;
+        mpz_import(t.get_mpz_t(), neg.size(), -1, sizeof(mp_limb_t), 0, 0,
+            neg.data());
+        r -= t;
+    }
+}
+
+/*! Sets `c` to the `n` coefficients of `r = sum(c[i] * 2**(i*N))`, for
+    `|c[i]| < 2**(N-1)`. The fields of `|r|` are read from its limbs and
+    taken as balanced digits, in `[-2**(N-1), 2**(N-1))`.
+*/
+static void kronecker_unpack(const mpz_class &r, std::size_t N,
+        std::size_t n, std::vector<mpz_class> &c)
+{
+    mpz_srcptr R = r.get_mpz_t();
+    std::size_t L = (N + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+    unsigned top = N % GMP_NUMB_BITS;
+    std::vector<mp_limb_t> field(L);
+    mpz_class half, full;
+    mpz_setbit(half.get_mpz_t(), N - 1);
+    mpz_setbit(full.get_mpz_t(), N);
+    bool carry = false;
+    c.resize(n);
+    for (std::size_t i = 0; i < n; i++) {
+        for (std::size_t k = 0; k < L; k++)
+            field[k] = limb_at(R, i * N + k * GMP_NUMB_BITS);
+        if (top != 0) field[L - 1] &= (mp_limb_t(1) << top) - 1;
+        mpz_ptr d = c[i].get_mpz_t();
+        mpz_import(d, L, -1, sizeof(mp_limb_t), 0, 0, field.data());
+        if (carry) mpz_add_ui(d, d, 1);
+        carry = mpz_cmp(d, half.get_mpz_t()) >= 0;
+        if (carry) mpz_sub(d, d, full.get_mpz_t());
+    }
+    SYMENGINE_ASSERT(not carry)
+    if (mpz_sgn(R) < 0) {
+        for (auto &x : c)
+            mpz_neg(x.get_mpz_t(), x.get_mpz_t());
+    }
+}
+
+//Calculates bit length of number, used in mul_uni_poly() and poly_mul()
+template <typename T>
+unsigned int bit_length(T t){
+    unsigned int count = 0;
+    while (t > 0) {
+        count++;
+        t = t >> 1;
+    }
+    return count;
+}
+
 mpz_class UnivariatePolynomial::eval_bit(const int &x) const {
-    //TODO: Use Horner's Scheme
-    mpz_class ans = 0;
+    // The terms are added into limbs at their offsets, instead of shifting
+    // and adding integers
+    std::size_t bits = 0;
     for (const auto &p : dict_) {
-        mpz_class temp = 1;
-        temp <<= x * p.first;
-        ans += p.second * temp;
+        bits = std::max(bits, static_cast<std::size_t>(x) * p.first
+            + mpz_sizeinbase(p.second.get_mpz_t(), 2));
     }
+    std::vector<mp_limb_t> pos(
+        (bits + bit_length(dict_.size())) / GMP_NUMB_BITS + 2, 0), neg;
+    for (const auto &p : dict_)
+        add_term(pos, neg, p.second, static_cast<std::size_t>(x) * p.first);
+    mpz_class ans;
+    limbs_to_mpz(pos, neg, ans);
     return ans;
 }
 
@@ -223,63 +333,229 @@ RCP<const UnivariatePolynomial> sub_uni_poly(const UnivariatePolynomial &a, cons
     return c;
 }
 
-//Calculates bit length of number, used in mul_uni_poly() only
-template <typename T>
-unsigned int bit_length(T t){
-    unsigned int count = 0;
-    while (t > 0) {
-        count++;
-        t = t >> 1;
-    }
-    return count;
-}
-
 RCP<const UnivariatePolynomial> mul_uni_poly(RCP<const UnivariatePolynomial> a, RCP<const UnivariatePolynomial> b) {
     //TODO: Use `const RCP<const UnivariatePolynomial> &a` for input arguments,
     //      even better is use `const UnivariatePolynomial &a`
     unsigned int da = a->degree_;
     unsigned int db = b->degree_;
 
-    int sign = 1;
-    if ((--(a->dict_.end()))->second < 0) {
-        a = neg_uni_poly(*a);
-        sign = -1 * sign;
+    // Kronecker substitution: the coefficients of the product are below
+    // 2**(N-1) in absolute value, so they are the balanced base 2**N digits
+    // of the product of the polynomials evaluated at 2**N
+    std::size_t bits_a = 0, bits_b = 0;
+    for (const auto &it : a->dict_)
+        bits_a = std::max(bits_a, mpz_sizeinbase(it.second.get_mpz_t(), 2));
+    for (const auto &it : b->dict_)
+        bits_b = std::max(bits_b, mpz_sizeinbase(it.second.get_mpz_t(), 2));
+    unsigned int N = bit_length(std::min(da + 1, db + 1)) + bits_a + bits_b + 1;
+
+    mpz_class r = a->eval_bit(N) * b->eval_bit(N);
+    std::vector<mpz_class> v;
+    kronecker_unpack(r, N, da + db + 1, v);
+    return make_rcp<const UnivariatePolynomial>(a->var_, v);
+}
+
+DenseUniPoly::DenseUniPoly(std::vector<mpz_class> &&c) : c(std::move(c))
+{
+    normalize();
+}
+
+DenseUniPoly::DenseUniPoly(const UnivariatePolynomial &p)
+{
+    c.resize(p.degree_ + 1);
+    for (const auto &it : p.dict_)
+        c[it.first] = it.second;
+    normalize();
+}
+
+void DenseUniPoly::normalize()
+{
+    while (not c.empty() and c.back() == 0)
+        c.pop_back();
+}
+
+RCP<const Basic> DenseUniPoly::as_basic(const RCP<const Symbol> &var) const
+{
+    if (c.empty()) return zero;
+    map_uint_mpz d;
+    for (unsigned int i = 0; i < c.size(); i++) {
+        if (c[i] != 0) d.emplace_hint(d.end(), i, c[i]);
+    }
+    return UnivariatePolynomial::from_dict(var, std::move(d));
+}
+
+//! Below this length of the shorter factor, poly_mul() multiplies on machine
+//! words if the coefficients are small enough
+static const std::size_t word_threshold = 40;
+//! From this length of the shorter factor, poly_mul() uses Kronecker
+//! substitution instead of the schoolbook method
+static const std::size_t kronecker_threshold = 8;
+//! Below this length of the shorter factor, Karatsuba's method falls back to
+//! the schoolbook method
+static const std::size_t karatsuba_threshold = 16;
+
+//! \return the number of bits of the largest absolute value in `a`
+static std::size_t max_bits(const std::vector<mpz_class> &a)
+{
+    std::size_t bits = 0;
+    for (const auto &x : a)
+        bits = std::max(bits, mpz_sizeinbase(x.get_mpz_t(), 2));
+    return bits;
+}
+
+//! Adds `a*b` to `r`, which has `na + nb - 1` coefficients
+static void mul_schoolbook(const mpz_class *a, std::size_t na,
+        const mpz_class *b, std::size_t nb, mpz_class *r)
+{
+    for (std::size_t i = 0; i < na; i++) {
+        if (a[i] == 0) continue;
+        for (std::size_t j = 0; j < nb; j++)
+            mpz_addmul(r[i + j].get_mpz_t(), a[i].get_mpz_t(),
+                b[j].get_mpz_t());
+    }
+}
+
+//! Adds `a*b` to `r`, which has `na + nb - 1` coefficients
+static void mul_karatsuba(const mpz_class *a, std::size_t na,
+        const mpz_class *b, std::size_t nb, mpz_class *r)
+{
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb < karatsuba_threshold) {
+        mul_schoolbook(a, na, b, nb, r);
+        return;
+    }
+    std::size_t m = (na + 1) / 2;
+    if (nb <= m) {
+        // Too unbalanced to split both, `b` is multiplied by slices of `a`
+        for (std::size_t i = 0; i < na; i += nb)
+            mul_karatsuba(a + i, std::min(nb, na - i), b, nb, r + i);
+        return;
     }
-    if ((--(b->dict_.end()))->second < 0) {
-        b = neg_uni_poly(*b);
-        sign = -1 * sign;
+    // With a = a0 + x**m*a1 and b = b0 + x**m*b1, a*b is
+    // z0 + x**m*((a0 + a1)*(b0 + b1) - z0 - z2) + x**(2*m)*z2
+    std::size_t na1 = na - m, nb1 = nb - m;
+    std::vector<mpz_class> sa(a, a + m), sb(b, b + m);
+    for (std::size_t i = 0; i < na1; i++)
+        sa[i] += a[m + i];
+    for (std::size_t i = 0; i < nb1; i++)
+        sb[i] += b[m + i];
+    std::vector<mpz_class> z0(2 * m - 1), z1(2 * m - 1), z2(na1 + nb1 - 1);
+    mul_karatsuba(a, m, b, m, z0.data());
+    mul_karatsuba(a + m, na1, b + m, nb1, z2.data());
+    mul_karatsuba(sa.data(), m, sb.data(), m, z1.data());
+    for (std::size_t i = 0; i < z0.size(); i++) {
+        z1[i] -= z0[i];
+        r[i] += z0[i];
+    }
+    for (std::size_t i = 0; i < z2.size(); i++) {
+        z1[i] -= z2[i];
+        r[2 * m + i] += z2[i];
+    }
+    for (std::size_t i = 0; i < z1.size(); i++)
+        r[m + i] += z1[i];
+}
+
+//! Computes `C = A*B` on machine words if the coefficients of the product
+//! fit
+//! \return false if they might not fit
+static bool mul_small(const DenseUniPoly &A, const DenseUniPoly &B,
+        DenseUniPoly &C)
+{
+    std::size_t na = A.c.size(), nb = B.c.size();
+    if (max_bits(A.c) + max_bits(B.c) + bit_length(std::min(na, nb))
+            > static_cast<std::size_t>(std::numeric_limits<long>::digits))
+        return false;
+    std::vector<long> a(na), b(nb), r(na + nb - 1, 0);
+    for (std::size_t i = 0; i < na; i++)
+        a[i] = mpz_get_si(A.c[i].get_mpz_t());
+    for (std::size_t j = 0; j < nb; j++)
+        b[j] = mpz_get_si(B.c[j].get_mpz_t());
+    for (std::size_t i = 0; i < na; i++) {
+        if (a[i] == 0) continue;
+        for (std::size_t j = 0; j < nb; j++)
+            r[i + j] += a[i] * b[j];
     }
+    C.c.resize(r.size());
+    for (std::size_t k = 0; k < r.size(); k++)
+        mpz_set_si(C.c[k].get_mpz_t(), r[k]);
+    return true;
+}
 
-    mpz_class p = std::max(a->max_coef(), b->max_coef());
-    unsigned int N = bit_length(std::min(da + 1, db + 1)) + bit_length(p) + 1;
+void poly_mul_schoolbook(const DenseUniPoly &A, const DenseUniPoly &B,
+        DenseUniPoly &C)
+{
+    if (A.c.empty() or B.c.empty()) {
+        C.c.clear();
+        return;
+    }
+    std::vector<mpz_class> r(A.c.size() + B.c.size() - 1);
+    mul_schoolbook(A.c.data(), A.c.size(), B.c.data(), B.c.size(), r.data());
+    C.c = std::move(r);
+}
 
-    mpz_class a1 = 1 << N;
-    mpz_class a2 = a1 / 2;
-    mpz_class mask = a1 - 1;
-    mpz_class sa = a->eval_bit(N);
-    mpz_class sb = b->eval_bit(N);
-    mpz_class r = sa*sb;
+void poly_mul_karatsuba(const DenseUniPoly &A, const DenseUniPoly &B,
+        DenseUniPoly &C)
+{
+    if (A.c.empty() or B.c.empty()) {
+        C.c.clear();
+        return;
+    }
+    std::vector<mpz_class> r(A.c.size() + B.c.size() - 1);
+    mul_karatsuba(A.c.data(), A.c.size(), B.c.data(), B.c.size(), r.data());
+    C.c = std::move(r);
+}
 
-    std::vector<mpz_class> v;
-    mpz_class carry = 0;
+/*! Sets `r = sum(a[i] * 2**(i*N))`, for `|a[i]| < 2**(N-1)`. The fields do
+    not overlap, so the coefficients are each written into limbs directly,
+    instead of shifting and adding integers.
+*/
+static void kronecker_pack(const std::vector<mpz_class> &a, std::size_t N,
+        mpz_class &r)
+{
+    std::vector<mp_limb_t> pos(a.size() * N / GMP_NUMB_BITS + 2, 0), neg;
+    for (std::size_t i = 0; i < a.size(); i++)
+        add_term(pos, neg, a[i], i * N);
+    limbs_to_mpz(pos, neg, r);
+}
 
-    while (r != 0 or carry != 0) {
+void poly_mul_kronecker(const DenseUniPoly &A, const DenseUniPoly &B,
+        DenseUniPoly &C)
+{
+    if (A.c.empty() or B.c.empty()) {
+        C.c.clear();
+        return;
+    }
+    std::size_t N = max_bits(A.c) + max_bits(B.c)
+        + bit_length(std::min(A.c.size(), B.c.size())) + 1;
+    mpz_class a, r;
+    kronecker_pack(A.c, N, a);
+    if (&A == &B) {
+        // GMP squares faster than it multiplies
+        mpz_mul(r.get_mpz_t(), a.get_mpz_t(), a.get_mpz_t());
+    } else {
         mpz_class b;
-        mpz_and(b.get_mpz_t(), r.get_mpz_t(), mask.get_mpz_t());
-        if (b < a2) {
-            v.push_back(b + carry);
-            carry = 0;
-        } else {
-            v.push_back(b - a1 + carry);
-            carry = 1;
-        }
-        r >>= N;
+        kronecker_pack(B.c, N, b);
+        mpz_mul(r.get_mpz_t(), a.get_mpz_t(), b.get_mpz_t());
     }
+    kronecker_unpack(r, N, A.c.size() + B.c.size() - 1, C.c);
+}
 
-    if (sign == -1)
-        return neg_uni_poly(*make_rcp<const UnivariatePolynomial>(a->var_, v));
-    else
-        return make_rcp<const UnivariatePolynomial>(a->var_, v);
+void poly_mul(const DenseUniPoly &A, const DenseUniPoly &B, DenseUniPoly &C)
+{
+    if (A.c.empty() or B.c.empty()) {
+        C.c.clear();
+        return;
+    }
+    std::size_t n = std::min(A.c.size(), B.c.size());
+    if (n < word_threshold and mul_small(A, B, C)) return;
+    if (n < kronecker_threshold) {
+        poly_mul_schoolbook(A, B, C);
+    } else {
+        poly_mul_kronecker(A, B, C);
+    }
 }
 
 } // SymEngine
@@ -101,6 +101,57 @@ inline RCP<const UnivariatePolynomial> univariate_polynomial(RCP<const Symbol> i
     return make_rcp<const UnivariatePolynomial>(i, deg, std::move(dict));
 }
 
+/*! Dense univariate polynomial with integer coefficients: `c[i]` is the
+    coefficient of `x**i`. The last coefficient is nonzero, the zero
+    polynomial has no coefficients.
+
+    Unlike UnivariatePolynomial it is not a Basic and it stores all the
+    coefficients contiguously, for arithmetic on dense polynomials.
+*/
+class DenseUniPoly {
+public:
+    std::vector<mpz_class> c;
+
+    DenseUniPoly() {}
+    //! Takes the coefficients `c`, dropping trailing zeros
+    explicit DenseUniPoly(std::vector<mpz_class> &&c);
+    explicit DenseUniPoly(const UnivariatePolynomial &p);
+
+    //! \return the degree, -1 for the zero polynomial
+    inline int degree() const {
+        return static_cast<int>(c.size()) - 1;
+    }
+    //! Drops trailing zero coefficients
+    void normalize();
+    //! \return the polynomial as a Basic in the variable `var`
+    RCP<const Basic> as_basic(const RCP<const Symbol> &var) const;
+
+    inline bool operator==(const DenseUniPoly &o) const {
+        return c == o.c;
+    }
+};
+
+/*! Multiplies two polynomials: `C = A*B`. Short factors use the schoolbook
+    method, on machine words if the coefficients are small enough, and
+    longer ones Kronecker substitution (a single multiplication of integers
+    by GMP), which is faster than Karatsuba's method from a length of about
+    8 for all sizes of coefficients.
+*/
+void poly_mul(const DenseUniPoly &A, const DenseUniPoly &B, DenseUniPoly &C);
+//! Multiplies two polynomials: `C = A*B` by the schoolbook method
+void poly_mul_schoolbook(const DenseUniPoly &A, const DenseUniPoly &B,
+        DenseUniPoly &C);
+//! Multiplies two polynomials: `C = A*B` by Karatsuba's method
+void poly_mul_karatsuba(const DenseUniPoly &A, const DenseUniPoly &B,
+        DenseUniPoly &C);
+/*! Multiplies two polynomials: `C = A*B` by Kronecker substitution. The
+    coefficients are packed into the limbs of one integer each, at a
+    spacing wide enough for the coefficients of the product, and the
+    product of the integers is unpacked.
+*/
+void poly_mul_kronecker(const DenseUniPoly &A, const DenseUniPoly &B,
+        DenseUniPoly &C);
+
 }  //SymEngine
 
 #endif
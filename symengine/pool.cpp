@@ -0,0 +1,178 @@
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#    include <malloc.h>
+#endif
+
+#include <symengine/pool.h>
+#include <symengine/symengine_assert.h>
+
+namespace SymEngine {
+
+//! Chunks are aligned to their size, so the chunk of a block is found by
+//! masking its address.
+static const std::size_t chunk_size = 1 << 16;
+
+//! Header at the start of every chunk
+struct PoolChunk {
+    //! The arena owning the chunk, or nullptr for the pool of a thread
+    BasicArena *arena;
+    PoolChunk *next;
+    //! Number of allocated blocks, only kept for arena chunks
+    std::size_t live;
+};
+
+static const std::size_t header_size
+    = (sizeof(PoolChunk) + Pool::granularity - 1)
+        / Pool::granularity * Pool::granularity;
+
+// Both are zero initialized, so accessing them needs no initialization guard.
+// The chunks of a thread are never released, its instances can be freed by
+// other threads after it exits.
+static thread_local Pool thread_pool;
+static thread_local BasicArena *current_arena = nullptr;
+
+static inline PoolChunk *chunk_of(void *p)
+{
+    return reinterpret_cast<PoolChunk *>(
+        reinterpret_cast<std::size_t>(p) & ~(chunk_size - 1));
+}
+
+static PoolChunk *new_chunk(Pool &pool, BasicArena *arena)
+{
+    void *raw;
+#ifdef _WIN32
+    raw = _aligned_malloc(chunk_size, chunk_size);
+#else
+    if (posix_memalign(&raw, chunk_size, chunk_size) != 0) raw = nullptr;
+#endif
+    if (raw == nullptr) throw std::bad_alloc();
+    PoolChunk *c = static_cast<PoolChunk *>(raw);
+    c->arena = arena;
+    c->next = pool.chunks_;
+    c->live = 0;
+    pool.chunks_ = c;
+    pool.cur_ = static_cast<char *>(raw) + header_size;
+    pool.end_ = static_cast<char *>(raw) + chunk_size;
+    return c;
+}
+
+static void free_chunk(PoolChunk *c)
+{
+#ifdef _WIN32
+    _aligned_free(c);
+#else
+    std::free(c);
+#endif
+}
+
+//! Gives the part of the current chunk of `pool` not carved yet to the free
+//! lists of `to`, in blocks of the largest classes that fit
+static void carve_rest(Pool &pool, Pool &to)
+{
+    while (pool.cur_ != pool.end_) {
+        std::size_t rest = (pool.end_ - pool.cur_) / Pool::granularity;
+        std::size_t c = (rest < Pool::n_classes ? rest : Pool::n_classes) - 1;
+        *reinterpret_cast<void **>(pool.cur_) = to.free_[c];
+        to.free_[c] = pool.cur_;
+        pool.cur_ += (c + 1) * Pool::granularity;
+    }
+}
+
+static inline void *pool_pop(Pool &pool, std::size_t cls, BasicArena *arena)
+{
+    void *p = pool.free_[cls];
+    if (p != nullptr) {
+        pool.free_[cls] = *static_cast<void **>(p);
+        return p;
+    }
+    std::size_t size = (cls + 1) * Pool::granularity;
+    // There is no chunk before the first allocation
+    if (pool.cur_ == nullptr or std::size_t(pool.end_ - pool.cur_) < size) {
+        carve_rest(pool, pool);
+        new_chunk(pool, arena);
+    }
+    p = pool.cur_;
+    pool.cur_ += size;
+    return p;
+}
+
+void *pool_allocate(std::size_t size)
+{
+    if (size > Pool::max_size) return ::operator new(size);
+    std::size_t cls = (size - 1) / Pool::granularity;
+    BasicArena *arena = current_arena;
+    if (arena == nullptr) return pool_pop(thread_pool, cls, nullptr);
+    void *p = pool_pop(arena->pool_, cls, arena);
+    chunk_of(p)->live++;
+    arena->live_++;
+    return p;
+}
+
+void pool_deallocate(void *p, std::size_t size)
+{
+    if (size > Pool::max_size) {
+        ::operator delete(p);
+        return;
+    }
+    std::size_t cls = (size - 1) / Pool::granularity;
+    PoolChunk *c = chunk_of(p);
+    Pool *pool = &thread_pool;
+    if (c->arena != nullptr) {
+        pool = &c->arena->pool_;
+        c->live--;
+        c->arena->live_--;
+    }
+    *static_cast<void **>(p) = pool->free_[cls];
+    pool->free_[cls] = p;
+}
+
+BasicArena::BasicArena() : pool_(), prev_{current_arena}, live_{0}
+{
+    current_arena = this;
+}
+
+BasicArena::~BasicArena()
+{
+    SYMENGINE_ASSERT(current_arena == this)
+    current_arena = prev_;
+
+    // Chunks with live instances move to the pool of the thread, together
+    // with their free blocks and the part of the current chunk not carved
+    // yet. The others are released.
+    if (pool_.cur_ != pool_.end_ and chunk_of(pool_.cur_)->live != 0)
+        carve_rest(pool_, thread_pool);
+    PoolChunk *c = pool_.chunks_, *dead = nullptr;
+    while (c != nullptr) {
+        PoolChunk *next = c->next;
+        if (c->live != 0) {
+            c->arena = nullptr;
+            c->next = thread_pool.chunks_;
+            thread_pool.chunks_ = c;
+        } else {
+            c->next = dead;
+            dead = c;
+        }
+        c = next;
+    }
+    if (live_ != 0) {
+        for (std::size_t cls = 0; cls < Pool::n_classes; cls++) {
+            void *p = pool_.free_[cls];
+            while (p != nullptr) {
+                void *next = *static_cast<void **>(p);
+                if (chunk_of(p)->arena == nullptr) {
+                    *static_cast<void **>(p) = thread_pool.free_[cls];
+                    thread_pool.free_[cls] = p;
+                }
+                p = next;
+            }
+        }
+    }
+    while (dead != nullptr) {
+        PoolChunk *next = dead->next;
+        free_chunk(dead);
+        dead = next;
+    }
+}
+
+} // SymEngine
@@ -0,0 +1,77 @@
+/**
+ *  \file pool.h
+ *  Size class pool allocator for Basic instances
+ *
+ **/
+#ifndef SYMENGINE_POOL_H
+#define SYMENGINE_POOL_H
+
+#include <cstddef>
+
+namespace SymEngine {
+
+struct PoolChunk;
+
+//! Free lists and the chunk being carved of one pool
+struct Pool {
+    //! Number of size classes, in steps of `granularity` bytes
+    static const std::size_t n_classes = 16;
+    static const std::size_t granularity = 16;
+    //! Largest instance served by the pools, bigger ones use `operator new`
+    static const std::size_t max_size = n_classes * granularity;
+
+    void *free_[n_classes];
+    char *cur_, *end_;
+    PoolChunk *chunks_;
+};
+
+/*! Allocates `size` bytes for a Basic instance from the free lists of the
+    current thread (or of the innermost BasicArena of the thread). Used by
+    `Basic::operator new`, so that everything created by `make_rcp()` comes
+    from the pool.
+*/
+void *pool_allocate(std::size_t size);
+
+/*! Releases memory returned by `pool_allocate(size)`. It can be called from
+    any thread, except for instances created in a BasicArena.
+*/
+void pool_deallocate(void *p, std::size_t size);
+
+/*! While an instance of BasicArena is alive, all Basic instances created by
+    the same thread are allocated from chunks owned by the arena. When the
+    arena is destroyed the chunks are released at once, so the memory of all
+    the temporaries of a computation goes back to the system together
+    instead of staying in the free lists of the thread. Chunks that still
+    hold referenced instances (e.g. the result of the computation) are
+    handed over to the pool of the thread, so they never dangle.
+
+        {
+            BasicArena arena;
+            r = expand(e);
+        }
+
+    Arenas nest and must be destroyed in reverse order of creation, by the
+    thread that created them. Instances allocated in an arena must be
+    released on that thread as well.
+*/
+class BasicArena {
+private:
+    Pool pool_;
+    BasicArena *prev_;
+    std::size_t live_;
+    friend void *pool_allocate(std::size_t size);
+    friend void pool_deallocate(void *p, std::size_t size);
+public:
+    BasicArena();
+    ~BasicArena();
+
+    BasicArena(const BasicArena &) = delete;
+    BasicArena &operator=(const BasicArena &) = delete;
+
+    //! \return the number of instances allocated in the arena still alive
+    inline std::size_t size() const { return live_; }
+};
+
+} // SymEngine
+
+#endif
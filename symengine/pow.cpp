@@ -8,6 +8,7 @@
 #include <symengine/complex.h>
 #include <symengine/constants.h>
 #include <symengine/polynomial.h>
+#include <symengine/visitor.h>
 
 namespace SymEngine {
 
@@ -128,12 +129,12 @@ RCP<const Basic> pow(const RCP<const Basic> &a, const RCP<const Basic> &b)
             } else if (is_a<Integer>(*a)) {
                 return static_cast<const Rational &>(*b).rpowrat(static_cast<const Integer &>(*a));
             } else if (is_a<Complex>(*a)) {
-                return make_rcp<const Pow>(a, b);
+                return intern(make_rcp<const Pow>(a, b));
             } else {
                 return rcp_static_cast<const Number>(a)->pow(*rcp_static_cast<const Number>(b));
             }
         } else if (is_a<Complex>(*b)) {
-            return make_rcp<const Pow>(a, b);
+            return intern(make_rcp<const Pow>(a, b));
         } else {
             return rcp_static_cast<const Number>(a)->pow(*rcp_static_cast<const Number>(b));
         }
@@ -150,7 +151,7 @@ RCP<const Basic> pow(const RCP<const Basic> &a, const RCP<const Basic> &b)
         RCP<const Pow> A = rcp_static_cast<const Pow>(a);
         return pow(A->get_base(), mul(A->get_exp(), b));
     }
-    return make_rcp<const Pow>(a, b);
+    return intern(make_rcp<const Pow>(a, b));
 }
 
 // This function can overflow, but it is fast.
@@ -245,16 +246,7 @@ void multinomial_coefficients_mpz(int m, int n, map_vec_mpz &r)
 
 RCP<const Basic> Pow::subs(const map_basic_basic &subs_dict) const
 {
-    RCP<const Pow> self = rcp_from_this_cast<const Pow>();
-    auto it = subs_dict.find(self);
-    if (it != subs_dict.end())
-        return it->second;
-    RCP<const Basic> base_new = base_->subs(subs_dict);
-    RCP<const Basic> exp_new = exp_->subs(subs_dict);
-    if (base_new == base_ and exp_new == exp_)
-        return self;
-    else
-        return pow(base_new, exp_new);
+    return SubsVisitor(subs_dict).apply(rcp_from_this());
 }
 
 vec_basic Pow::get_args() const {
@@ -319,16 +311,7 @@ int Log::compare(const Basic &o) const
 
 RCP<const Basic> Log::subs(const map_basic_basic &subs_dict) const
 {
-    RCP<const Log> self = rcp_from_this_cast<const Log>();
-    auto it = subs_dict.find(self);
-    if (it != subs_dict.end())
-        return it->second;
-    RCP<const Basic> arg_new = arg_->subs(subs_dict);
-    if (arg_new == arg_) {
-        return self;
-    } else {
-        return log(arg_new);
-    }
+    return SubsVisitor(subs_dict).apply(rcp_from_this());
 }
 
 RCP<const Basic> log(const RCP<const Basic> &arg)
@@ -41,6 +41,10 @@ public:
     virtual RCP<const Basic> subs(const map_basic_basic &subs_dict) const;
 
     virtual vec_basic get_args() const;
+    virtual void for_each_arg(const ArgFunction &f) const {
+        f(*base_);
+        f(*exp_);
+    }
 };
 
 //! \return Pow from `a` and `b`
@@ -83,6 +87,7 @@ public:
     //! \return `arg` of `log(arg)`
     inline RCP<const Basic> get_arg() const { return arg_; }
     virtual vec_basic get_args() const { return {arg_}; }
+    virtual void for_each_arg(const ArgFunction &f) const { f(*arg_); }
     virtual RCP<const Basic> subs(const map_basic_basic &subs_dict) const;
 };
 
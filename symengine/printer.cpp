@@ -1,4 +1,7 @@
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <limits>
 
 #include <symengine/printer.h>
@@ -473,4 +476,202 @@ std::vector<std::string> init_str_printer_names() {
 
 const std::vector<std::string> StrPrinter::names_ = init_str_printer_names();
 
+//! Prints `d` so that it is read back as the same double. Infinities and
+//! NaN (also from integers too large for a double) use the macros of
+//! <math.h>.
+static std::string print_double(double d)
+{
+    // Read from the bits, as -ffast-math turns std::isinf() and std::isnan()
+    // into false
+    static_assert(sizeof(double) == sizeof(std::uint64_t),
+        "double must be an IEEE 754 binary64");
+    std::uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(d));
+    const std::uint64_t exponent = 0x7ff0000000000000ULL;
+    if ((bits & exponent) == exponent) {
+        if ((bits & ~(exponent | (1ULL << 63))) != 0)
+            return "NAN";
+        return bits >> 63 ? "-INFINITY" : "INFINITY";
+    }
+    std::ostringstream s;
+    s.precision(std::numeric_limits<double>::max_digits10);
+    s << d;
+    std::string str = s.str();
+    if (str.find_first_of(".eni") == std::string::npos) {
+        str += ".0";
+    }
+    return str;
+}
+
+void CCodePrinter::set_symbol_name(const RCP<const Basic> &x,
+        const std::string &name) {
+    symbols_[x] = name;
+}
+
+void CCodePrinter::bvisit(const Basic &x) {
+    throw std::runtime_error("Not implemented.");
+}
+
+void CCodePrinter::bvisit(const Symbol &x) {
+    auto it = symbols_.find(x.rcp_from_this());
+    if (it != symbols_.end()) {
+        str_ = it->second;
+    } else {
+        str_ = x.get_name();
+    }
+}
+
+void CCodePrinter::bvisit(const Integer &x) {
+    str_ = print_double(x.i.get_d());
+}
+
+void CCodePrinter::bvisit(const Rational &x) {
+    str_ = print_double(x.i.get_d());
+}
+
+void CCodePrinter::bvisit(const RealDouble &x) {
+    str_ = print_double(x.i);
+}
+
+#ifdef HAVE_SYMENGINE_MPFR
+void CCodePrinter::bvisit(const RealMPFR &x) {
+    str_ = print_double(mpfr_get_d(x.i.get_mpfr_t(), MPFR_RNDN));
+}
+#endif
+
+std::string CCodePrinter::print_pow(const RCP<const Basic> &base,
+        const RCP<const Basic> &exp) {
+    if (eq(*exp, *one)) {
+        return parenthesizeLT(base, PrecedenceEnum::Mul);
+    } else if (eq(*base, *E)) {
+        return "exp(" + apply(exp) + ")";
+    } else if (eq(*exp, *div(one, integer(2)))) {
+        return "sqrt(" + apply(base) + ")";
+    } else {
+        return "pow(" + apply(base) + ", " + apply(exp) + ")";
+    }
+}
+
+void CCodePrinter::bvisit(const Mul &x) {
+    std::ostringstream o, o2;
+    bool num = false;
+    unsigned den = 0;
+    std::map<RCP<const Basic>, RCP<const Basic>,
+            RCPBasicKeyLessCmp> dict(x.dict_.begin(), x.dict_.end());
+
+    if (eq(*(x.coef_), *minus_one)) {
+        o << "-";
+    } else if (neq(*(x.coef_), *one)) {
+        o << parenthesizeLT(x.coef_, PrecedenceEnum::Mul) << "*";
+        num = true;
+    }
+
+    for (const auto &p: dict) {
+        if (is_a_Number(*p.second) and
+                rcp_static_cast<const Number>(p.second)->is_negative()) {
+            o2 << print_pow(p.first, neg(p.second)) << "*";
+            den++;
+        } else {
+            o << print_pow(p.first, p.second) << "*";
+            num = true;
+        }
+    }
+
+    if (not num) {
+        o << "1.0*";
+    }
+
+    std::string s = o.str();
+    s = s.substr(0, s.size() - 1);
+
+    if (den != 0) {
+        std::string s2 = o2.str();
+        s2 = s2.substr(0, s2.size() - 1);
+        if (den > 1) {
+            str_ = s + "/(" + s2 + ")";
+        } else {
+            str_ = s + "/" + s2;
+        }
+    } else {
+        str_ = s;
+    }
+}
+
+void CCodePrinter::bvisit(const Pow &x) {
+    str_ = print_pow(x.get_base(), x.get_exp());
+}
+
+void CCodePrinter::bvisit(const Constant &x) {
+    if (eq(x, *pi)) {
+        str_ = print_double(std::atan2(0, -1));
+    } else if (eq(x, *E)) {
+        str_ = print_double(std::exp(1));
+    } else {
+        throw std::runtime_error("Constant " + x.get_name() + " is not implemented.");
+    }
+}
+
+void CCodePrinter::bvisit(const Function &x) {
+    vec_basic args = x.get_args();
+    std::string arg = apply(args[0]);
+    switch (x.get_type_code()) {
+        case SIN: case COS: case TAN: case ASIN: case ACOS: case ATAN:
+        case SINH: case COSH: case TANH: case ASINH: case ACOSH: case ATANH:
+            str_ = names_[x.get_type_code()] + "(" + arg + ")";
+            break;
+        case ATAN2:
+            str_ = "atan2(" + arg + ", " + apply(args[1]) + ")";
+            break;
+        case COT: str_ = "(1.0/tan(" + arg + "))"; break;
+        case CSC: str_ = "(1.0/sin(" + arg + "))"; break;
+        case SEC: str_ = "(1.0/cos(" + arg + "))"; break;
+        case COTH: str_ = "(1.0/tanh(" + arg + "))"; break;
+        case CSCH: str_ = "(1.0/sinh(" + arg + "))"; break;
+        case SECH: str_ = "(1.0/cosh(" + arg + "))"; break;
+        case ACOT: str_ = "atan(1.0/(" + arg + "))"; break;
+        case ASEC: str_ = "acos(1.0/(" + arg + "))"; break;
+        case ACSC: str_ = "asin(1.0/(" + arg + "))"; break;
+        case ACOTH: str_ = "atanh(1.0/(" + arg + "))"; break;
+        case ASECH: str_ = "acosh(1.0/(" + arg + "))"; break;
+        case ACSCH: str_ = "asinh(1.0/(" + arg + "))"; break;
+        case ABS: str_ = "fabs(" + arg + ")"; break;
+        case GAMMA: str_ = "tgamma(" + arg + ")"; break;
+        default:
+            throw std::runtime_error("Not implemented.");
+    }
+}
+
+std::string ccode(const Basic &x)
+{
+    CCodePrinter p;
+    return p.apply(x);
+}
+
+std::string ccode_function(const std::string &name, const vec_basic &args,
+        const vec_basic &exprs)
+{
+    vec_pair replacements;
+    vec_basic reduced;
+    cse(replacements, reduced, exprs);
+
+    CCodePrinter p;
+    for (unsigned i = 0; i < args.size(); i++) {
+        p.set_symbol_name(args[i], "in[" + std::to_string(i) + "]");
+    }
+    std::ostringstream o;
+    o << "#include <math.h>\n\n";
+    o << "void " << name << "(double *out, const double *in)\n{\n";
+    for (unsigned i = 0; i < replacements.size(); i++) {
+        std::string t = "t" + std::to_string(i);
+        o << "    const double " << t << " = "
+            << p.apply(replacements[i].second) << ";\n";
+        p.set_symbol_name(replacements[i].first, t);
+    }
+    for (unsigned i = 0; i < reduced.size(); i++) {
+        o << "    out[" << i << "] = " << p.apply(reduced[i]) << ";\n";
+    }
+    o << "}\n";
+    return o.str();
+}
+
 }
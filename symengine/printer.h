@@ -161,6 +161,72 @@ public:
     std::string apply(const Basic &b);
 };
 
+/*! Prints an expression as a C99 expression in double precision. Numbers
+    are printed as double literals (so that `1/2` is not an integer
+    division), powers use `pow()`, `sqrt()` or `exp()` and the reciprocal
+    functions are written in terms of the ones in `<math.h>`. Anything that
+    cannot be evaluated in C throws a `std::runtime_error`.
+*/
+class CCodePrinter : public BaseVisitor<CCodePrinter, StrPrinter> {
+protected:
+    std::map<RCP<const Basic>, std::string, RCPBasicKeyLess> symbols_;
+    std::string print_pow(const RCP<const Basic> &base,
+            const RCP<const Basic> &exp);
+public:
+    using StrPrinter::bvisit;
+
+    //! Prints the symbol `x` as `name` (e.g. `in[0]`) instead of its name
+    void set_symbol_name(const RCP<const Basic> &x, const std::string &name);
+
+    void bvisit(const Basic &x);
+    void bvisit(const Symbol &x);
+    void bvisit(const Integer &x);
+    void bvisit(const Rational &x);
+    void bvisit(const RealDouble &x);
+#ifdef HAVE_SYMENGINE_MPFR
+    void bvisit(const RealMPFR &x);
+#endif
+    void bvisit(const Mul &x);
+    void bvisit(const Pow &x);
+    void bvisit(const Constant &x);
+    void bvisit(const Function &x);
+    // Complex numbers, undefined functions and derivatives have no C
+    // equivalent
+    void bvisit(const Complex &x) { bvisit(static_cast<const Basic &>(x)); }
+    void bvisit(const ComplexDouble &x) {
+        bvisit(static_cast<const Basic &>(x));
+    }
+#ifdef HAVE_SYMENGINE_MPC
+    void bvisit(const ComplexMPC &x) { bvisit(static_cast<const Basic &>(x)); }
+#endif
+    void bvisit(const FunctionSymbol &x) {
+        bvisit(static_cast<const Basic &>(x));
+    }
+    void bvisit(const Derivative &x) { bvisit(static_cast<const Basic &>(x)); }
+    void bvisit(const Subs &x) { bvisit(static_cast<const Basic &>(x)); }
+    void bvisit(const UnivariatePolynomial &x) {
+        bvisit(static_cast<const Basic &>(x));
+    }
+    void bvisit(const NumberWrapper &x) {
+        bvisit(static_cast<const Basic &>(x));
+    }
+};
+
+//! \return `x` printed as a C expression
+std::string ccode(const Basic &x);
+
+/*! \return the source of a self-contained C function
+
+        #include <math.h>
+        void name(double *out, const double *in)
+
+    evaluating `exprs` into `out[0], out[1], ...` for the values of the
+    symbols `args` given in `in`. Common subexpressions (see `cse()`) are
+    computed once into local variables.
+*/
+std::string ccode_function(const std::string &name, const vec_basic &args,
+        const vec_basic &exprs);
+
 }
 
 #endif //SYMENGINE_PRINTER_H
@@ -5,11 +5,69 @@
 namespace SymEngine {
 
 Rational::Rational(mpq_class i)
-    : i{i}
 {
+    mpz_set_inline(mpq_numref(this->i.get_mpq_t()), &limbs_[0],
+        mpq_numref(i.get_mpq_t()));
+    mpz_set_inline(mpq_denref(this->i.get_mpq_t()), &limbs_[1],
+        mpq_denref(i.get_mpq_t()));
     SYMENGINE_ASSERT(is_canonical(this->i))
 }
 
+Rational::Rational(long n, long d)
+{
+    SYMENGINE_ASSERT(d > 1)
+    mpz_set_inline(mpq_numref(this->i.get_mpq_t()), &limbs_[0], n < 0,
+        n < 0 ? 0UL - static_cast<unsigned long>(n)
+            : static_cast<unsigned long>(n));
+    mpz_set_inline(mpq_denref(this->i.get_mpq_t()), &limbs_[1], false,
+        static_cast<unsigned long>(d));
+    SYMENGINE_ASSERT(is_canonical(this->i))
+}
+
+Rational::~Rational()
+{
+    mpz_release_inline(mpq_numref(this->i.get_mpq_t()), &limbs_[0]);
+    mpz_release_inline(mpq_denref(this->i.get_mpq_t()), &limbs_[1]);
+}
+
+RCP<const Number> Rational::from_small(long n, long d)
+{
+    if (d == 1) return integer(n);
+    return make_rcp<const Rational>(n, d);
+}
+
+bool Rational::add_small(long n1, long d1, long n2, long d2, long &n,
+        long &d)
+{
+    // n1/d1 + n2/d2 = (n1*(d2/g) + n2*(d1/g)) / (d1*(d2/g)), g = gcd(d1, d2)
+    long g = ulong_gcd(d1, d2), t1, t2;
+    if (not checked_mul(n1, d2 / g, t1) or not checked_mul(n2, d1 / g, t2)
+            or not checked_add(t1, t2, n) or not checked_mul(d1, d2 / g, d))
+        return false;
+    g = ulong_gcd(n < 0 ? 0UL - static_cast<unsigned long>(n)
+        : static_cast<unsigned long>(n), d);
+    n /= g;
+    d /= g;
+    return true;
+}
+
+bool Rational::mul_small(long n1, long d1, long n2, long d2, long &n,
+        long &d)
+{
+    if (n1 == 0 or n2 == 0) {
+        n = 0;
+        d = 1;
+        return true;
+    }
+    // Both fractions are canonical, so only the cross terms can cancel
+    long g1 = ulong_gcd(n1 < 0 ? 0UL - static_cast<unsigned long>(n1)
+        : static_cast<unsigned long>(n1), d2);
+    long g2 = ulong_gcd(n2 < 0 ? 0UL - static_cast<unsigned long>(n2)
+        : static_cast<unsigned long>(n2), d1);
+    return checked_mul(n1 / g1, n2 / g2, n)
+        and checked_mul(d1 / g2, d2 / g1, d);
+}
+
 bool Rational::is_canonical(const mpq_class &i) const
 {
     mpq_class x = i;
@@ -64,8 +122,8 @@ std::size_t Rational::__hash__() const
     // only the least significant bits that fit into "signed long int" are
     // hashed:
     std::size_t seed = RATIONAL;
-    hash_combine<long long int>(seed, this->i.get_num().get_si());
-    hash_combine<long long int>(seed, this->i.get_den().get_si());
+    hash_combine<long long int>(seed, mpz_hash_bits(this->i.get_num_mpz_t()));
+    hash_combine<long long int>(seed, mpz_hash_bits(this->i.get_den_mpz_t()));
     return seed;
 }
 
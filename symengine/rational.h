@@ -18,10 +18,27 @@ public:
     //! `i` : object of `mpq_class`
     mpq_class i;
 
+private:
+    //! Storage of the numerator and denominator of `i` when they have a
+    //! single limb, see `Integer::limb_`
+    mp_limb_t limbs_[2];
+
+    //! \return `n/d` (in canonical form) as an Integer or Rational
+    static RCP<const Number> from_small(long n, long d);
+    //! Sets `n/d` to `n1/d1 + n2/d2`, false if it does not fit in a `long`
+    static bool add_small(long n1, long d1, long n2, long d2, long &n,
+            long &d);
+    //! Sets `n/d` to `n1/d1 * n2/d2`, false if it does not fit in a `long`
+    static bool mul_small(long n1, long d1, long n2, long d2, long &n,
+            long &d);
+
 public:
     IMPLEMENT_TYPEID(RATIONAL)
     //! Constructor of Rational class
     explicit Rational(mpq_class i);
+    //! Constructor of `n/d`, which must be in canonical form with `d > 1`
+    Rational(long n, long d);
+    ~Rational();
     /*! \param `i` must already be in mpq_class canonical form
     *   \return Integer or Rational depending on denumerator.
     * */
@@ -61,7 +78,15 @@ public:
     }
     //! \return negative of self
     inline RCP<const Rational> neg() const {
-        return make_rcp<Rational>(-this->i);
+        long n, d;
+        if (get_small(n, d) and n != LONG_MIN)
+            return make_rcp<const Rational>(-n, d);
+        return make_rcp<const Rational>(-this->i);
+    }
+    //! \return true and the numerator and denominator if both fit in a `long`
+    inline bool get_small(long &n, long &d) const {
+        return mpz_get_small(i.get_num_mpz_t(), n)
+            and mpz_get_small(i.get_den_mpz_t(), d);
     }
     //! \return numerator of self
     inline RCP<const Integer> get_num() const {
@@ -80,39 +105,67 @@ public:
      * \param other of type Rational
      * */
     inline RCP<const Number> addrat(const Rational &other) const {
+        long n1, d1, n2, d2, n, d;
+        if (get_small(n1, d1) and other.get_small(n2, d2)
+                and add_small(n1, d1, n2, d2, n, d))
+            return from_small(n, d);
         return from_mpq(this->i + other.i);
     }
     /*! Add Rationals
      * \param other of type Integer
      * */
     inline RCP<const Number> addrat(const Integer &other) const {
+        long n1, d1, n2, n, d;
+        if (get_small(n1, d1) and other.get_small(n2)
+                and add_small(n1, d1, n2, 1, n, d))
+            return from_small(n, d);
         return from_mpq(this->i + other.i);
     }
     /*! Subtract Rationals
      * \param other of type Rational
      * */
     inline RCP<const Number> subrat(const Rational &other) const {
+        long n1, d1, n2, d2, n, d;
+        if (get_small(n1, d1) and other.get_small(n2, d2) and n2 != LONG_MIN
+                and add_small(n1, d1, -n2, d2, n, d))
+            return from_small(n, d);
         return from_mpq(this->i - other.i);
     }
     /*! Subtract Rationals
      * \param other of type Integer
      * */
     inline RCP<const Number> subrat(const Integer &other) const {
+        long n1, d1, n2, n, d;
+        if (get_small(n1, d1) and other.get_small(n2) and n2 != LONG_MIN
+                and add_small(n1, d1, -n2, 1, n, d))
+            return from_small(n, d);
         return from_mpq(this->i - other.i);
     }
     inline RCP<const Number> rsubrat(const Integer &other) const {
+        long n1, d1, n2, n, d;
+        if (get_small(n1, d1) and other.get_small(n2) and n1 != LONG_MIN
+                and add_small(n2, 1, -n1, d1, n, d))
+            return from_small(n, d);
         return from_mpq(other.i - this->i);
     }
     /*! Multiply Rationals
      * \param other of type Rational
      * */
     inline RCP<const Number> mulrat(const Rational &other) const {
+        long n1, d1, n2, d2, n, d;
+        if (get_small(n1, d1) and other.get_small(n2, d2)
+                and mul_small(n1, d1, n2, d2, n, d))
+            return from_small(n, d);
         return from_mpq(this->i * other.i);
     }
     /*! Multiply Rationals
      * \param other of type Integer
      * */
     inline RCP<const Number> mulrat(const Integer &other) const {
+        long n1, d1, n2, n, d;
+        if (get_small(n1, d1) and other.get_small(n2)
+                and mul_small(n1, d1, n2, 1, n, d))
+            return from_small(n, d);
         return from_mpq(this->i * other.i);
     }
     /*! Divide Rationals
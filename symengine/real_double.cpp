@@ -15,8 +15,7 @@ RealDouble::RealDouble(double i) {
 
 std::size_t RealDouble::__hash__() const
 {
-    std::hash<double> hash_fn;
-    return hash_fn(i);
+    return stable_hash<double>(i);
 }
 
 bool RealDouble::__eq__(const Basic &o) const
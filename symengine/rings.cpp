@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <symengine/basic.h>
 #include <symengine/add.h>
 #include <symengine/mul.h>
@@ -8,7 +10,13 @@
 
 namespace SymEngine {
 
-void expr2poly(const RCP<const Basic> &p, umap_basic_num &syms, umap_vec_mpz &P)
+/*
+   Calls `term(exp, coef)` for each term of the expression `p`, with the
+   exponents of the symbols `syms` in `exp`.
+*/
+template <typename F>
+static void expr2poly_terms(const RCP<const Basic> &p, umap_basic_num &syms,
+        F term)
 {
     if (is_a<Add>(*p)) {
         int n = syms.size();
@@ -52,42 +60,293 @@ void expr2poly(const RCP<const Basic> &p, umap_basic_num &syms, umap_vec_mpz &P)
                 throw std::runtime_error("Not implemented.");
             }
 
-            P[exp] = coef;
+            term(exp, coef);
         }
     } else {
         throw std::runtime_error("Not implemented.");
     }
 }
 
+void expr2poly(const RCP<const Basic> &p, umap_basic_num &syms, umap_vec_mpz &P)
+{
+    expr2poly_terms(p, syms, [&](const vec_int &exp, const mpz_class &coef) {
+        P[exp] = coef;
+    });
+}
+
+void expr2poly(const RCP<const Basic> &p, umap_basic_num &syms, SparsePoly &P)
+{
+    P = SparsePoly(syms.size());
+    expr2poly_terms(p, syms, [&](const vec_int &exp, const mpz_class &coef) {
+        P.dict[P.pack(exp)] = coef;
+    });
+}
+
+SparsePoly::SparsePoly(unsigned n) : n{n}, bits{bits_for(n)}
+{
+    if (bits == 0)
+        throw std::runtime_error("SparsePoly: too many variables.");
+}
+
+unsigned SparsePoly::bits_for(unsigned n)
+{
+    // Each word holds a power of two number of fields
+    unsigned bits = 32;
+    while (bits >= 4 and n > 128 / bits) bits /= 2;
+    return bits >= 4 ? bits : 0;
+}
+
+packed_monomial SparsePoly::pack(const vec_int &exp) const
+{
+    SYMENGINE_ASSERT(exp.size() == n)
+    const unsigned per_word = 64 / bits;
+    packed_monomial m = {{0, 0}};
+    for (unsigned i = 0; i < n; i++) {
+        if (exp[i] < 0 or (bits < 32 and exp[i] >= (1 << bits)))
+            throw std::runtime_error("SparsePoly: exponent out of range.");
+        m.w[i / per_word] |= std::uint64_t(exp[i])
+            << (bits * (i % per_word));
+    }
+    return m;
+}
+
+void SparsePoly::unpack(const packed_monomial &m, vec_int &exp) const
+{
+    const unsigned per_word = 64 / bits;
+    const std::uint64_t mask = (std::uint64_t(1) << bits) - 1;
+    exp.resize(n);
+    for (unsigned i = 0; i < n; i++) {
+        exp[i] = (m.w[i / per_word] >> (bits * (i % per_word))) & mask;
+    }
+}
+
+vec_int SparsePoly::max_degrees() const
+{
+    vec_int result(n, 0), exp;
+    for (const auto &p: dict) {
+        unpack(p.first, exp);
+        for (unsigned i = 0; i < n; i++) {
+            if (exp[i] > result[i]) result[i] = exp[i];
+        }
+    }
+    return result;
+}
+
+//! \return true if a product with degrees `a[i] + b[i]` fits in `bits` bits
+static bool degrees_fit(const vec_int &a, const vec_int &b, unsigned bits)
+{
+    for (unsigned i = 0; i < a.size(); i++) {
+        if (a[i] < 0 or b[i] < 0) return false;
+        if ((std::uint64_t(a[i]) + std::uint64_t(b[i])) >> bits != 0)
+            return false;
+    }
+    return true;
+}
+
 void poly_mul(const umap_vec_mpz &A, const umap_vec_mpz &B, umap_vec_mpz &C)
 {
+    if (A.empty() or B.empty()) return;
+    unsigned n = (A.begin()->first).size();
+    unsigned bits = SparsePoly::bits_for(n);
+    if (bits != 0) {
+        vec_int da(n, 0), db(n, 0);
+        for (const auto &a: A) {
+            for (unsigned i = 0; i < n; i++)
+                da[i] = std::max(da[i], a.first[i]);
+            if (*std::min_element(a.first.begin(), a.first.end()) < 0)
+                bits = 0;
+        }
+        for (const auto &b: B) {
+            for (unsigned i = 0; i < n; i++)
+                db[i] = std::max(db[i], b.first[i]);
+            if (*std::min_element(b.first.begin(), b.first.end()) < 0)
+                bits = 0;
+        }
+        if (bits != 0 and degrees_fit(da, db, bits)) {
+            SparsePoly PA(n), PB(n), PC(n);
+            for (const auto &a: A) PA.dict[PA.pack(a.first)] = a.second;
+            for (const auto &b: B) PB.dict[PB.pack(b.first)] = b.second;
+            poly_mul(PA, PB, PC);
+            vec_int exp;
+            for (const auto &c: PC.dict) {
+                PC.unpack(c.first, exp);
+                mpz_add(C[exp].get_mpz_t(), C[exp].get_mpz_t(),
+                    c.second.get_mpz_t());
+            }
+            return;
+        }
+    }
+
+    // Negative exponents or too many variables
     vec_int exp;
-    int n = (A.begin()->first).size();
     exp.assign(n, 0); // Initialize to [0]*n
-    /*
-    std::cout << "A: " << A.load_factor() << " " << A.bucket_count() << " " << A.size() << " "
-        << A.max_bucket_count() << std::endl;
-    std::cout << "B: " << B.load_factor() << " " << B.bucket_count() << " " << B.size() << " "
-        << B.max_bucket_count() << std::endl;
-    std::cout << "C: " << C.load_factor() << " " << C.bucket_count() << " " << C.size() << " "
-        << C.max_bucket_count() << std::endl;
-        */
     for (const auto &a: A) {
         for (const auto &b: B) {
             monomial_mul(a.first, b.first, exp);
             mpz_addmul(C[exp].get_mpz_t(), a.second.get_mpz_t(), b.second.get_mpz_t());
         }
     }
-    /*
-    std::cout << "C: " << C.load_factor() << " " << C.bucket_count() << " " << C.size() << " "
-        << C.max_bucket_count() << std::endl;
-    for (const std::size_t n=0; n < C.bucket_count(); n++) {
-        std::cout << n << ": " << C.bucket_size(n) << "|";
-        for (auto it = C.begin(n); it != C.end(n); ++it)
-            std::cout << " " << it->first << myhash2(it->first) % C.bucket_count();
-        std::cout << std::endl;
+}
+
+void poly_mul(const SparsePoly &A, const SparsePoly &B, SparsePoly &C)
+{
+    if (A.n != B.n)
+        throw std::runtime_error("poly_mul: different number of variables.");
+    if (not degrees_fit(A.max_degrees(), B.max_degrees(), A.bits))
+        throw std::runtime_error("poly_mul: exponents of the product do not fit.");
+    if (C.n != A.n) C = SparsePoly(A.n);
+    for (const auto &a: A.dict) {
+        for (const auto &b: B.dict) {
+            mpz_addmul(C.dict[a.first + b.first].get_mpz_t(),
+                a.second.get_mpz_t(), b.second.get_mpz_t());
+        }
+    }
+}
+
+typedef std::vector<const std::pair<const packed_monomial, mpz_class> *>
+    vec_packed_term;
+
+//! \return pointers to the terms of `P` in decreasing monomial order
+static vec_packed_term sorted_terms(const SparsePoly &P)
+{
+    vec_packed_term terms;
+    terms.reserve(P.dict.size());
+    for (const auto &p: P.dict) terms.push_back(&p);
+    std::sort(terms.begin(), terms.end(),
+        [](const std::pair<const packed_monomial, mpz_class> *a,
+                const std::pair<const packed_monomial, mpz_class> *b) {
+            return b->first < a->first;
+        });
+    return terms;
+}
+
+namespace {
+/*
+   Binary heap of the products `a[i]*b[j]` of poly_mul_heap(), with at most
+   one product per row `i` (the next one of the row to be merged). Products
+   with the same monomial are chained in one node, so that they are popped
+   at once and sifting is done only for distinct monomials.
+*/
+class ChainedHeap {
+    struct node {
+        packed_monomial m;
+        //! First row of the chain
+        unsigned row;
+    };
+    std::vector<node> heap_;
+    //! Column of the product of each row and the next row of its chain
+    std::vector<unsigned> col_, next_;
+
+public:
+    static const unsigned none = ~0U;
+
+    ChainedHeap(std::size_t rows) : col_(rows), next_(rows) {
+        heap_.reserve(rows);
+    }
+
+    bool empty() const { return heap_.empty(); }
+    const packed_monomial &top() const { return heap_[0].m; }
+    unsigned col(unsigned row) const { return col_[row]; }
+    unsigned next(unsigned row) const { return next_[row]; }
+
+    void push(const packed_monomial &m, unsigned row, unsigned col) {
+        col_[row] = col;
+        next_[row] = none;
+        std::size_t pos = heap_.size();
+        // Find the position first, chaining to an equal ancestor if any
+        while (pos > 0) {
+            std::size_t parent = (pos - 1) / 2;
+            if (heap_[parent].m == m) {
+                next_[row] = heap_[parent].row;
+                heap_[parent].row = row;
+                return;
+            }
+            if (not (heap_[parent].m < m)) break;
+            pos = parent;
+        }
+        std::size_t hole = heap_.size();
+        heap_.push_back({m, row});
+        while (hole > pos) {
+            std::size_t parent = (hole - 1) / 2;
+            heap_[hole] = heap_[parent];
+            hole = parent;
+        }
+        heap_[pos] = {m, row};
+    }
+
+    //! Removes the top node, \return the first row of its chain
+    unsigned pop() {
+        unsigned row = heap_[0].row;
+        node last = heap_.back();
+        heap_.pop_back();
+        std::size_t n = heap_.size(), pos = 0;
+        if (n == 0) return row;
+        while (true) {
+            std::size_t child = 2 * pos + 1;
+            if (child >= n) break;
+            if (child + 1 < n and heap_[child].m < heap_[child + 1].m) child++;
+            if (not (last.m < heap_[child].m)) break;
+            heap_[pos] = heap_[child];
+            pos = child;
+        }
+        heap_[pos] = last;
+        return row;
+    }
+};
+}
+
+void poly_mul_heap(const SparsePoly &A, const SparsePoly &B,
+        vec_packed_mpz &C)
+{
+    if (A.n != B.n)
+        throw std::runtime_error("poly_mul: different number of variables.");
+    if (not degrees_fit(A.max_degrees(), B.max_degrees(), A.bits))
+        throw std::runtime_error("poly_mul: exponents of the product do not fit.");
+    C.clear();
+    if (A.dict.empty() or B.dict.empty()) return;
+    // The heap holds one product per row of `a`, so `a` is the shorter one
+    vec_packed_term a = sorted_terms(A.dict.size() <= B.dict.size() ? A : B);
+    vec_packed_term b = sorted_terms(A.dict.size() <= B.dict.size() ? B : A);
+
+    ChainedHeap heap(a.size());
+    std::vector<unsigned> rows;
+    heap.push(a[0]->first + b[0]->first, 0, 0);
+    mpz_class coef;
+    while (not heap.empty()) {
+        // Pop all the products with the largest monomial
+        const packed_monomial m = heap.top();
+        coef = 0;
+        rows.clear();
+        do {
+            for (unsigned i = heap.pop(); i != ChainedHeap::none;
+                    i = heap.next(i)) {
+                mpz_addmul(coef.get_mpz_t(), a[i]->second.get_mpz_t(),
+                    b[heap.col(i)]->second.get_mpz_t());
+                rows.push_back(i);
+            }
+        } while (not heap.empty() and heap.top() == m);
+
+        // Replace them by the next products of their rows. The row `i + 1`
+        // starts once the first product of the row `i` is out, as all its
+        // products are smaller.
+        for (unsigned i: rows) {
+            unsigned j = heap.col(i);
+            if (j == 0 and i + 1 < a.size())
+                heap.push(a[i + 1]->first + b[0]->first, i + 1, 0);
+            if (j + 1 < b.size())
+                heap.push(a[i]->first + b[j + 1]->first, i, j + 1);
+        }
+        if (coef != 0) C.push_back(std::make_pair(m, coef));
     }
-    */
+}
+
+void poly_mul_heap(const SparsePoly &A, const SparsePoly &B, SparsePoly &C)
+{
+    vec_packed_mpz terms;
+    poly_mul_heap(A, B, terms);
+    C = SparsePoly(A.n);
+    C.dict.reserve(terms.size());
+    for (auto &t: terms) C.dict.insert(std::move(t));
 }
 
 } // SymEngine
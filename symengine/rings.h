@@ -6,17 +6,98 @@
 #ifndef SYMENGINE_RINGS_H
 #define SYMENGINE_RINGS_H
 
+#include <cstdint>
+
 #include <symengine/basic.h>
 #include <symengine/dict.h>
 
 namespace SymEngine {
 
+//! Exponents of a monomial of SparsePoly, packed into two words
+struct packed_monomial {
+    std::uint64_t w[2];
+
+    inline bool operator==(const packed_monomial &o) const {
+        return w[0] == o.w[0] and w[1] == o.w[1];
+    }
+    //! Multiplication of the monomials
+    inline packed_monomial operator+(const packed_monomial &o) const {
+        return {{w[0] + o.w[0], w[1] + o.w[1]}};
+    }
+    //! Monomial order, compatible with multiplication
+    inline bool operator<(const packed_monomial &o) const {
+        return w[1] < o.w[1] or (w[1] == o.w[1] and w[0] < o.w[0]);
+    }
+};
+
+//! Part of umap_packed_mpz:
+struct packed_monomial_hash {
+    inline std::size_t operator() (const packed_monomial &k) const {
+        return (k.w[0] ^ (k.w[1] * 0x9e3779b97f4a7c15ULL))
+            * 0xff51afd7ed558ccdULL;
+    }
+};
+
+typedef std::unordered_map<packed_monomial, mpz_class,
+        packed_monomial_hash> umap_packed_mpz;
+//! Terms of a SparsePoly
+typedef std::vector<std::pair<packed_monomial, mpz_class>> vec_packed_mpz;
+
+/*! Sparse multivariate polynomial with integer coefficients and
+    non-negative exponents, packed `bits` bits per variable into
+    `packed_monomial`. Multiplying two monomials is then an addition of
+    words and hashing one is a multiplication, instead of a loop over a
+    `vec_int` that is allocated for each term.
+
+    Up to 4 variables have 32 bits, up to 8 have 16 bits and so on, up to 32
+    variables. `pack()` checks the exponents, `poly_mul()` checks that the
+    degrees of the product fit.
+*/
+class SparsePoly {
+public:
+    //! Number of variables
+    unsigned n;
+    //! Bits per exponent
+    unsigned bits;
+    umap_packed_mpz dict;
+
+    explicit SparsePoly(unsigned n = 0);
+
+    //! \return the packed form of the exponents `exp`
+    packed_monomial pack(const vec_int &exp) const;
+    //! Stores the exponents of `m` in `exp`
+    void unpack(const packed_monomial &m, vec_int &exp) const;
+    //! \return the maximum exponent of each variable
+    vec_int max_degrees() const;
+    //! \return the bits per exponent for `n` variables, 0 if too many
+    static unsigned bits_for(unsigned n);
+};
+
 //! Converts expression `p` into a polynomial `P`, with symbols `sym`
 void expr2poly(const RCP<const Basic> &p, umap_basic_num &syms,
         umap_vec_mpz &P);
+//! Converts expression `p` into a polynomial `P`, with symbols `sym`
+void expr2poly(const RCP<const Basic> &p, umap_basic_num &syms,
+        SparsePoly &P);
 
-//! Multiply two polynomials: `C = A*B`
+/*! Multiply two polynomials: `C = A*B`. The product is computed with
+    SparsePoly if the exponents can be packed.
+*/
 void poly_mul(const umap_vec_mpz &A, const umap_vec_mpz &B, umap_vec_mpz &C);
+//! Multiply two polynomials: `C = A*B`
+void poly_mul(const SparsePoly &A, const SparsePoly &B, SparsePoly &C);
+
+/*! Multiply two polynomials with a heap (Johnson's algorithm, as in
+    Monagan and Pearce): the terms of `C = A*B` are generated one at a time
+    in decreasing monomial order, merging the products `A[i]*B` through a
+    binary heap of at most `min(|A|, |B|)` entries. Unlike `poly_mul()`,
+    which updates a hash table for each of the `|A|*|B|` products, the
+    working memory is `O(|A| + |B|)` and `C` is written sequentially.
+*/
+void poly_mul_heap(const SparsePoly &A, const SparsePoly &B,
+        vec_packed_mpz &C);
+//! Multiply two polynomials: `C = A*B` using `poly_mul_heap()`
+void poly_mul_heap(const SparsePoly &A, const SparsePoly &B, SparsePoly &C);
 
 } // SymEngine
 
@@ -15,11 +15,10 @@ RCP<const URatPSeriesFlint> URatPSeriesFlint::series(const RCP<const Basic> &t,
 }
 
 std::size_t URatPSeriesFlint::__hash__() const {
-    std::hash<std::string> str_hash;
     std::size_t seed = URATPSERIESFLINT;
     hash_combine(seed, var_);
     hash_combine(seed, degree_);
-    hash_combine(seed, str_hash(p_.to_string()));
+    hash_combine(seed, stable_hash<std::string>(p_.to_string()));
     return seed;
 }
 
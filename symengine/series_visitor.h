@@ -217,15 +217,15 @@ public:
     }
 
     void bvisit(const Pow &pow) {
-        auto base = pow.get_base();
-        auto exp = pow.get_exp();
-        map_basic_basic subsx0{{x_, integer(0)}};
-        // exp(const) or x^-1
-        if ((base->__eq__(*E) and exp->subs(subsx0)->__neq__(*integer(0)))
-            or (is_a_Number(*exp) and static_cast<const Number&>(*exp).is_negative()
-                and base->subs(subsx0)->__eq__(*integer(0)))) {
-            needs_ = true;
-            stop_ = true;
+        visit_pow(pow.get_base(), pow.get_exp());
+    }
+
+    // The traversal visits the factors of a Mul as base and exponent, not as
+    // a Pow
+    void bvisit(const Mul &mul) {
+        for (const auto &p: mul.dict_) {
+            visit_pow(p.first, p.second);
+            if (stop_) return;
         }
     }
 
@@ -242,6 +242,17 @@ public:
 
     void bvisit(const Basic &x) { }
 
+    void visit_pow(const RCP<const Basic> &base, const RCP<const Basic> &exp) {
+        map_basic_basic subsx0{{x_, integer(0)}};
+        // exp(const) or x^-1
+        if ((base->__eq__(*E) and exp->subs(subsx0)->__neq__(*integer(0)))
+            or (is_a_Number(*exp) and static_cast<const Number&>(*exp).is_negative()
+                and base->subs(subsx0)->__eq__(*integer(0)))) {
+            needs_ = true;
+            stop_ = true;
+        }
+    }
+
     bool apply(const Basic &b, const RCP<const Symbol> &x) {
         x_ = x;
         needs_ = false;
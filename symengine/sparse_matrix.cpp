@@ -1,9 +1,15 @@
 #include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <set>
 
 #include <symengine/matrix.h>
+#include <symengine/numeric_matrix.h>
 #include <symengine/add.h>
 #include <symengine/mul.h>
 #include <symengine/integer.h>
+#include <symengine/rational.h>
+#include <symengine/real_double.h>
 #include <symengine/constants.h>
 
 namespace SymEngine {
@@ -65,23 +71,12 @@ RCP<const Basic> CSRMatrix::get(unsigned i, unsigned j) const
 {
     SYMENGINE_ASSERT(i < row_ and j < col_);
 
-    unsigned row_start = p_[i];
-    unsigned row_end = p_[i + 1];
-    unsigned k;
-
-    if (row_start == row_end) {
-        return zero;
-    }
+    auto row_start = j_.begin() + p_[i];
+    auto row_end = j_.begin() + p_[i + 1];
+    auto k = std::lower_bound(row_start, row_end, j);
 
-    while (row_start <= row_end) {
-        k = (row_start + row_end)/2;
-        if (j_[k] == j) {
-            return x_[k];
-        } else if (j_[k] < j){
-            row_start = k + 1;
-        } else {
-            row_end = k - 1;
-        }
+    if (k != row_end and *k == j) {
+        return x_[k - j_.begin()];
     }
 
     return zero;
@@ -139,12 +134,33 @@ unsigned CSRMatrix::rank() const
 
 RCP<const Basic> CSRMatrix::det() const
 {
-    throw std::runtime_error("Not implemented.");
+    SYMENGINE_ASSERT(row_ == col_);
+    return csr_det(CSRSymbolicLU(*this), *this);
 }
 
 void CSRMatrix::inv(MatrixBase &result) const
 {
-    throw std::runtime_error("Not implemented.");
+    SYMENGINE_ASSERT(row_ == col_);
+    DenseMatrix I, X = DenseMatrix(row_, row_);
+    eye(I, row_);
+    csr_LU_solve(CSRSymbolicLU(*this), *this, I, X);
+
+    if (is_a<DenseMatrix>(result)) {
+        static_cast<DenseMatrix &>(result) = X;
+    } else if (is_a<CSRMatrix>(result)) {
+        std::vector<unsigned> i, j;
+        vec_basic x;
+        for (unsigned r = 0; r < row_; r++) {
+            for (unsigned c = 0; c < row_; c++) {
+                if (neq(*X.get(r, c), *zero)) {
+                    i.push_back(r);
+                    j.push_back(c);
+                    x.push_back(X.get(r, c));
+                }
+            }
+        }
+        static_cast<CSRMatrix &>(result) = from_coo(row_, row_, i, j, x);
+    }
 }
 
 void CSRMatrix::add_matrix(const MatrixBase &other, MatrixBase &result) const
@@ -188,7 +204,12 @@ void CSRMatrix::submatrix( unsigned row_start,
 // LU factorization
 void CSRMatrix::LU(MatrixBase &L, MatrixBase &U) const
 {
-    throw std::runtime_error("Not implemented.");
+    if (is_a<CSRMatrix>(L) and is_a<CSRMatrix>(U)) {
+        CSRMatrix &L_ = static_cast<CSRMatrix &>(L);
+        CSRMatrix &U_ = static_cast<CSRMatrix &>(U);
+        // Without reordering, so that A = L*U as for DenseMatrix
+        csr_LU(CSRSymbolicLU(*this, false), *this, L_, U_);
+    }
 }
 
 // LDL factorization
@@ -200,7 +221,11 @@ void CSRMatrix::LDL(MatrixBase &L, MatrixBase &D) const
 // Solve Ax = b using LU factorization
 void CSRMatrix::LU_solve(const MatrixBase &b, MatrixBase &x) const
 {
-    throw std::runtime_error("Not implemented.");
+    if (is_a<DenseMatrix>(b) and is_a<DenseMatrix>(x)) {
+        const DenseMatrix &b_ = static_cast<const DenseMatrix &>(b);
+        DenseMatrix &x_ = static_cast<DenseMatrix &>(x);
+        csr_LU_solve(CSRSymbolicLU(*this), *this, b_, x_);
+    }
 }
 
 // Fraction free LU factorization
@@ -465,29 +490,15 @@ void csr_diagonal(const CSRMatrix& A, DenseMatrix& D)
 
     SYMENGINE_ASSERT(D.nrows() == N and D.ncols() == 1);
 
-    unsigned row_start;
-    unsigned row_end;
-    RCP<const Basic> diag;
-
     for (unsigned i = 0; i < N; i++) {
-        row_start = A.p_[i];
-        row_end = A.p_[i + 1];
-        diag = zero;
-        unsigned jj;
-
-        while (row_start <= row_end) {
-            jj = (row_start + row_end)/2;
-            if (A.j_[jj] == i) {
-                diag = A.x_[jj];
-                break;
-            } else if (A.j_[jj] < i){
-                row_start = jj + 1;
-            } else {
-                row_end = jj - 1;
-            }
-        }
-
-        D.set(i, 0, diag);
+        auto row_start = A.j_.begin() + A.p_[i];
+        auto row_end = A.j_.begin() + A.p_[i + 1];
+        auto jj = std::lower_bound(row_start, row_end, i);
+
+        if (jj != row_end and *jj == i)
+            D.set(i, 0, A.x_[jj - A.j_.begin()]);
+        else
+            D.set(i, 0, zero);
     }
 }
 
@@ -605,4 +616,484 @@ void csr_binop_csr_canonical(const CSRMatrix& A, const CSRMatrix& B, CSRMatrix&
         CSRMatrix::csr_sum_duplicates(C.p_, C.j_, C.x_, A.row_);
 }
 
+// ------------------------------ Sparse LU ----------------------------------//
+
+/*! Orders the vertices of the graph `adj`, whose adjacency lists are sorted,
+    by minimum degree, or in their natural order if `order` is false. The
+    vertices are eliminated one at a time from the elimination graph, where
+    the neighbours of an eliminated vertex become a clique, and `reach[k]`
+    receives the neighbours of the `k`-th eliminated vertex `perm[k]`: the
+    pattern of its column of `L` and row of `U`.
+    Ties are broken by the smallest vertex, so that the ordering only depends
+    on the pattern.
+*/
+static void minimum_degree(std::vector<std::vector<unsigned>> &adj, bool order,
+        std::vector<unsigned> &perm, std::vector<std::vector<unsigned>> &reach)
+{
+    const unsigned n = adj.size();
+    std::set<std::pair<unsigned, unsigned>> degrees;
+    std::vector<unsigned> merged;
+
+    if (order) {
+        for (unsigned v = 0; v < n; v++)
+            degrees.insert(std::make_pair(adj[v].size(), v));
+    }
+    perm.resize(n);
+    reach.resize(n);
+
+    for (unsigned k = 0; k < n; k++) {
+        unsigned v = k;
+        if (order) {
+            v = degrees.begin()->second;
+            degrees.erase(degrees.begin());
+        }
+        perm[k] = v;
+
+        const std::vector<unsigned> &nbrs = adj[v];
+        for (unsigned u: nbrs) {
+            merged.clear();
+            std::set_union(adj[u].begin(), adj[u].end(), nbrs.begin(),
+                nbrs.end(), std::back_inserter(merged));
+            merged.erase(std::remove_if(merged.begin(), merged.end(),
+                [u, v](unsigned w) { return w == u or w == v; }),
+                merged.end());
+            if (order) {
+                degrees.erase(std::make_pair(adj[u].size(), u));
+                degrees.insert(std::make_pair(merged.size(), u));
+            }
+            adj[u].swap(merged);
+        }
+        reach[k] = std::move(adj[v]);
+        adj[v].clear();
+    }
+}
+
+CSRSymbolicLU::CSRSymbolicLU(const CSRMatrix &A, bool order)
+        : n_{A.row_}, ap_{A.p_}, aj_{A.j_}
+{
+    SYMENGINE_ASSERT(A.row_ == A.col_);
+    const unsigned n = n_;
+
+    // Pattern of A + A^T without the diagonal
+    std::vector<std::vector<unsigned>> adj(n), reach;
+    for (unsigned i = 0; i < n; i++) {
+        for (unsigned jj = ap_[i]; jj < ap_[i + 1]; jj++) {
+            if (aj_[jj] != i) {
+                adj[i].push_back(aj_[jj]);
+                adj[aj_[jj]].push_back(i);
+            }
+        }
+    }
+    for (auto &a: adj) {
+        std::sort(a.begin(), a.end());
+        a.erase(std::unique(a.begin(), a.end()), a.end());
+    }
+
+    minimum_degree(adj, order, perm_, reach);
+    iperm_.resize(n);
+    for (unsigned k = 0; k < n; k++)
+        iperm_[perm_[k]] = k;
+
+    // Row k of U is the diagonal followed by the reach of the k-th vertex,
+    // and the pattern of L is its transpose
+    up_.assign(n + 1, 0);
+    lp_.assign(n + 1, 0);
+    for (unsigned k = 0; k < n; k++) {
+        up_[k + 1] = up_[k] + 1 + reach[k].size();
+        for (unsigned u: reach[k])
+            lp_[iperm_[u] + 1]++;
+    }
+    for (unsigned k = 0; k < n; k++)
+        lp_[k + 1] += lp_[k];
+
+    uj_.resize(up_[n]);
+    lj_.resize(lp_[n]);
+    std::vector<unsigned> next(lp_.begin(), lp_.end() - 1);
+    for (unsigned k = 0; k < n; k++) {
+        unsigned *row = &uj_[up_[k]];
+        row[0] = k;
+        for (std::size_t t = 0; t < reach[k].size(); t++)
+            row[t + 1] = iperm_[reach[k][t]];
+        std::sort(row + 1, row + 1 + reach[k].size());
+        // Rows of L are filled by increasing k, hence sorted
+        for (std::size_t t = 0; t < reach[k].size(); t++)
+            lj_[next[row[t + 1]]++] = k;
+    }
+
+    map_.resize(ap_[n]);
+    for (unsigned i = 0; i < n; i++) {
+        const unsigned pi = iperm_[i];
+        for (unsigned jj = ap_[i]; jj < ap_[i + 1]; jj++) {
+            const unsigned pj = iperm_[aj_[jj]];
+            if (pj >= pi) {
+                map_[jj] = std::lower_bound(uj_.begin() + up_[pi],
+                    uj_.begin() + up_[pi + 1], pj) - uj_.begin();
+            } else {
+                map_[jj] = up_[n] + (std::lower_bound(lj_.begin() + lp_[pi],
+                    lj_.begin() + lp_[pi + 1], pj) - lj_.begin());
+            }
+        }
+    }
+}
+
+bool CSRSymbolicLU::matches(const CSRMatrix &A) const
+{
+    return A.row_ == n_ and A.col_ == n_ and A.p_ == ap_ and A.j_ == aj_;
+}
+
+// The arithmetic of the factorization, on numbers of the type of a numeric
+// domain or on Basic
+static inline void set_value(RCP<const Basic> &x, int v)
+{
+    x = integer(v);
+}
+
+template <typename T>
+static inline void set_value(T &x, int v)
+{
+    x = v;
+}
+
+static inline bool is_zero_value(const RCP<const Basic> &x)
+{
+    return is_a_Number(*x) and
+        rcp_static_cast<const Number>(x)->is_exact_zero();
+}
+
+static inline bool is_zero_value(const mpq_class &x)
+{
+    return sgn(x) == 0;
+}
+
+static inline bool is_zero_value(double x)
+{
+    return x == 0.0;
+}
+
+//! \return the magnitude of `x` if it is a double, else 0
+static inline double abs_value(double x)
+{
+    return std::abs(x);
+}
+
+template <typename T>
+static inline double abs_value(const T &)
+{
+    return 0.0;
+}
+
+//! w -= l*u
+static inline void sub_mul(RCP<const Basic> &w, const RCP<const Basic> &l,
+        const RCP<const Basic> &u)
+{
+    w = sub(w, mul(l, u));
+}
+
+template <typename T>
+static inline void sub_mul(T &w, const T &l, const T &u)
+{
+    w -= l * u;
+}
+
+//! w /= d
+static inline void div_value(RCP<const Basic> &w, const RCP<const Basic> &d)
+{
+    w = div(w, d);
+}
+
+template <typename T>
+static inline void div_value(T &w, const T &d)
+{
+    w /= d;
+}
+
+//! Double pivots smaller than this, relative to the largest entry of their
+//! row, are rejected as the pattern based ordering does not pivot
+static const double double_pivot_tolerance = 1e-8;
+
+/*! Computes the entries `lx` and `ux` of the factors `L` and `U`, in the
+    patterns of `S`, of the entries `ax` of the matrix analysed by `S`. The
+    rows are factored one at a time, from the rows of `U` above them.
+    \return false if a pivot is zero, or for doubles tiny
+*/
+template <typename T>
+static bool csr_lu_factor(const CSRSymbolicLU &S, const std::vector<T> &ax,
+        std::vector<T> &lx, std::vector<T> &ux)
+{
+    const unsigned n = S.n_, nu = S.up_[n];
+    T z;
+    set_value(z, 0);
+
+    lx.assign(S.lp_[n], z);
+    ux.assign(nu, z);
+    for (std::size_t jj = 0; jj < ax.size(); jj++) {
+        const unsigned slot = S.map_[jj];
+        if (slot < nu)
+            ux[slot] = ax[jj];
+        else
+            lx[slot - nu] = ax[jj];
+    }
+
+    std::vector<T> w(n, z);
+    for (unsigned i = 0; i < n; i++) {
+        double scale = 0.0;
+        for (unsigned kk = S.lp_[i]; kk < S.lp_[i + 1]; kk++) {
+            w[S.lj_[kk]] = lx[kk];
+            scale = std::max(scale, abs_value(lx[kk]));
+        }
+        for (unsigned kk = S.up_[i]; kk < S.up_[i + 1]; kk++) {
+            w[S.uj_[kk]] = ux[kk];
+            scale = std::max(scale, abs_value(ux[kk]));
+        }
+
+        for (unsigned kk = S.lp_[i]; kk < S.lp_[i + 1]; kk++) {
+            const unsigned k = S.lj_[kk];
+            if (is_zero_value(w[k]))
+                continue;
+            div_value(w[k], ux[S.up_[k]]);
+            for (unsigned uu = S.up_[k] + 1; uu < S.up_[k + 1]; uu++)
+                sub_mul(w[S.uj_[uu]], w[k], ux[uu]);
+        }
+
+        for (unsigned kk = S.lp_[i]; kk < S.lp_[i + 1]; kk++) {
+            lx[kk] = std::move(w[S.lj_[kk]]);
+            w[S.lj_[kk]] = z;
+        }
+        for (unsigned kk = S.up_[i]; kk < S.up_[i + 1]; kk++) {
+            ux[kk] = std::move(w[S.uj_[kk]]);
+            w[S.uj_[kk]] = z;
+        }
+
+        const T &pivot = ux[S.up_[i]];
+        if (is_zero_value(pivot)
+                or abs_value(pivot) < double_pivot_tolerance * scale)
+            return false;
+    }
+    return true;
+}
+
+//! Solves `A*X = B` for the `n` by `k` entries `b` of `B`, by substitutions
+//! with the factors `lx` and `ux` of `A` from `csr_lu_factor()`
+template <typename T>
+static void csr_lu_substitute(const CSRSymbolicLU &S, const std::vector<T> &lx,
+        const std::vector<T> &ux, const std::vector<T> &b, unsigned k,
+        std::vector<T> &x)
+{
+    const unsigned n = S.n_;
+    std::vector<T> y(n);
+    x.resize(std::size_t(n) * k);
+
+    for (unsigned c = 0; c < k; c++) {
+        for (unsigned i = 0; i < n; i++)
+            y[i] = b[std::size_t(S.perm_[i]) * k + c];
+        for (unsigned i = 0; i < n; i++) {
+            for (unsigned kk = S.lp_[i]; kk < S.lp_[i + 1]; kk++) {
+                if (not is_zero_value(y[S.lj_[kk]]))
+                    sub_mul(y[i], lx[kk], y[S.lj_[kk]]);
+            }
+        }
+        for (unsigned i = n; i-- > 0;) {
+            for (unsigned uu = S.up_[i] + 1; uu < S.up_[i + 1]; uu++) {
+                if (not is_zero_value(y[S.uj_[uu]]))
+                    sub_mul(y[i], ux[uu], y[S.uj_[uu]]);
+            }
+            div_value(y[i], ux[S.up_[i]]);
+        }
+        for (unsigned i = 0; i < n; i++)
+            x[std::size_t(S.perm_[i]) * k + c] = std::move(y[i]);
+    }
+}
+
+// Conversions of the entries between Basic and the numbers of their domain
+template <typename T>
+static void to_values(const vec_basic &v, std::vector<T> &t)
+{
+    NumericDenseMatrix<T> A;
+    to_numeric(v, 1, v.size(), A);
+    t = std::move(A.m_);
+}
+
+static void to_values(const vec_basic &v, vec_basic &t)
+{
+    t = v;
+}
+
+template <typename T>
+static void from_values(std::vector<T> &t, vec_basic &v)
+{
+    NumericDenseMatrix<T> A;
+    A.m_ = std::move(t);
+    from_numeric(A, v);
+}
+
+static void from_values(vec_basic &t, vec_basic &v)
+{
+    v = std::move(t);
+}
+
+//! Factors the entries `a` as `csr_lu_factor()` in the type `T`
+template <typename T>
+static bool csr_factor_in(const CSRSymbolicLU &S, const vec_basic &a,
+        vec_basic &l, vec_basic &u)
+{
+    std::vector<T> ax, lx, ux;
+    to_values(a, ax);
+    if (not csr_lu_factor(S, ax, lx, ux))
+        return false;
+    from_values(lx, l);
+    from_values(ux, u);
+    return true;
+}
+
+//! Solves `A*X = B` for the entries `a` of `A` and `b` of `B` in the type `T`
+template <typename T>
+static bool csr_solve_in(const CSRSymbolicLU &S, const vec_basic &a,
+        const vec_basic &b, unsigned k, vec_basic &x)
+{
+    std::vector<T> ax, lx, ux, bx, xx;
+    to_values(a, ax);
+    if (not csr_lu_factor(S, ax, lx, ux))
+        return false;
+    to_values(b, bx);
+    csr_lu_substitute(S, lx, ux, bx, k, xx);
+    from_values(xx, x);
+    return true;
+}
+
+static void check_pattern(const CSRSymbolicLU &S, const CSRMatrix &A)
+{
+    if (not S.matches(A))
+        throw std::runtime_error("Sparsity pattern does not match the analysis");
+}
+
+static DenseMatrix csr_to_dense(unsigned row, unsigned col,
+        const std::vector<unsigned> &p, const std::vector<unsigned> &j,
+        const vec_basic &x)
+{
+    DenseMatrix D = DenseMatrix(row, col);
+    for (unsigned i = 0; i < row; i++)
+        for (unsigned c = 0; c < col; c++)
+            D.set(i, c, zero);
+    for (unsigned i = 0; i < row; i++)
+        for (unsigned jj = p[i]; jj < p[i + 1]; jj++)
+            D.set(i, j[jj], x[jj]);
+    return D;
+}
+
+// Numeric matrices are factored with the numbers of their domain, integer
+// ones over the rationals, and symbolic ones on Basic.
+void csr_LU(const CSRSymbolicLU &S, const CSRMatrix &A, CSRMatrix &L,
+        CSRMatrix &U)
+{
+    check_pattern(S, A);
+    const unsigned n = S.n_;
+    vec_basic lx, ux;
+    bool factored;
+    switch (numeric_domain(A.x_)) {
+        case NumericDomain::integer:
+        case NumericDomain::rational:
+            factored = csr_factor_in<mpq_class>(S, A.x_, lx, ux);
+            break;
+        case NumericDomain::real_double:
+            factored = csr_factor_in<double>(S, A.x_, lx, ux);
+            break;
+        default:
+            factored = csr_factor_in<RCP<const Basic>>(S, A.x_, lx, ux);
+    }
+    if (not factored)
+        throw std::runtime_error("Zero pivot in sparse LU factorization");
+
+    std::vector<unsigned> lp(n + 1, 0), lj, up(n + 1, 0), uj;
+    vec_basic lv, uv;
+    for (unsigned i = 0; i < n; i++) {
+        for (unsigned kk = S.lp_[i]; kk < S.lp_[i + 1]; kk++) {
+            if (not is_zero_value(lx[kk])) {
+                lj.push_back(S.lj_[kk]);
+                lv.push_back(lx[kk]);
+            }
+        }
+        lj.push_back(i);
+        lv.push_back(one);
+        lp[i + 1] = lj.size();
+
+        for (unsigned kk = S.up_[i]; kk < S.up_[i + 1]; kk++) {
+            if (not is_zero_value(ux[kk])) {
+                uj.push_back(S.uj_[kk]);
+                uv.push_back(ux[kk]);
+            }
+        }
+        up[i + 1] = uj.size();
+    }
+    L = CSRMatrix(n, n, std::move(lp), std::move(lj), std::move(lv));
+    U = CSRMatrix(n, n, std::move(up), std::move(uj), std::move(uv));
+}
+
+// A zero pivot, for which the ordering of `S` would need pivoting, leaves the
+// system to LU_solve() on the DenseMatrix of `A`.
+void csr_LU_solve(const CSRSymbolicLU &S, const CSRMatrix &A,
+        const DenseMatrix &b, DenseMatrix &x)
+{
+    check_pattern(S, A);
+    const unsigned n = S.n_, k = b.ncols();
+    SYMENGINE_ASSERT(b.nrows() == n and x.nrows() == n and x.ncols() == k);
+
+    vec_basic bv(std::size_t(n) * k), xv;
+    for (unsigned i = 0; i < n; i++)
+        for (unsigned c = 0; c < k; c++)
+            bv[std::size_t(i) * k + c] = b.get(i, c);
+
+    bool solved;
+    switch (numeric_domain(numeric_domain(A.x_), numeric_domain(bv))) {
+        case NumericDomain::integer:
+        case NumericDomain::rational:
+            solved = csr_solve_in<mpq_class>(S, A.x_, bv, k, xv);
+            break;
+        case NumericDomain::real_double:
+            solved = csr_solve_in<double>(S, A.x_, bv, k, xv);
+            break;
+        default:
+            solved = csr_solve_in<RCP<const Basic>>(S, A.x_, bv, k, xv);
+    }
+
+    if (solved)
+        x = DenseMatrix(n, k, xv);
+    else
+        LU_solve(csr_to_dense(n, n, A.p_, A.j_, A.x_), b, x);
+}
+
+// The determinant of a numeric matrix is the product of its pivots. Symbolic
+// matrices, whose pivots are quotients of polynomials, and zero pivots are
+// left to the DenseMatrix of `A`.
+RCP<const Basic> csr_det(const CSRSymbolicLU &S, const CSRMatrix &A)
+{
+    check_pattern(S, A);
+    const unsigned n = S.n_;
+    switch (numeric_domain(A.x_)) {
+        case NumericDomain::integer:
+        case NumericDomain::rational: {
+            std::vector<mpq_class> ax, lx, ux;
+            to_values(A.x_, ax);
+            if (not csr_lu_factor(S, ax, lx, ux))
+                break;
+            mpq_class d = 1;
+            for (unsigned i = 0; i < n; i++)
+                d *= ux[S.up_[i]];
+            return Rational::from_mpq(d);
+        }
+        case NumericDomain::real_double: {
+            std::vector<double> ax, lx, ux;
+            to_values(A.x_, ax);
+            if (not csr_lu_factor(S, ax, lx, ux))
+                break;
+            double d = 1.0;
+            for (unsigned i = 0; i < n; i++)
+                d *= ux[S.up_[i]];
+            return real_double(d);
+        }
+        default:
+            break;
+    }
+    return csr_to_dense(n, n, A.p_, A.j_, A.x_).det();
+}
+
 } // SymEngine
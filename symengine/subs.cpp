@@ -0,0 +1,201 @@
+#include <symengine/visitor.h>
+
+namespace SymEngine {
+
+SubsVisitor::SubsVisitor(const map_basic_basic &subs_dict)
+    : subs_dict_(subs_dict), number_keys_{false}
+{
+    for (const auto &p: subs_dict_) {
+        key_types_[p.first->get_type_code()] = true;
+        if (is_a_Number(*p.first)) number_keys_ = true;
+    }
+}
+
+RCP<const Basic> SubsVisitor::apply(const RCP<const Basic> &x)
+{
+    auto it = subs_dict_.find(x);
+    if (it != subs_dict_.end())
+        return it->second;
+    // Atoms are only replaced as a whole, there is no need to cache them
+    if (is_a_Number(*x) or is_a<Symbol>(*x) or is_a<Constant>(*x))
+        return x;
+    auto c = cache_.find(x);
+    if (c != cache_.end())
+        return c->second;
+    x->accept(*this);
+    cache_.insert({x, result_});
+    return result_;
+}
+
+void SubsVisitor::bvisit(const Basic &x)
+{
+    // Classes without a specialized rule implement Basic::subs() themselves.
+    // Derivative and Subs substitute into their argument with dictionaries of
+    // their own, the rest only match keys as a whole, see apply().
+    result_ = x.subs(subs_dict_);
+}
+
+void SubsVisitor::bvisit(const Add &x)
+{
+    // Follows Add::subs(): a term `c*t` is replaced if `c*t` or the number
+    // `c` is a key. The probe `c*t` can only match a Mul key and `c` a
+    // number key, so they are skipped for dictionaries without such keys.
+    umap_basic_num d;
+    RCP<const Number> coef = x.coef_;
+    bool changed = false;
+    if (number_keys_) {
+        auto it = subs_dict_.find(x.coef_);
+        if (it != subs_dict_.end()) {
+            coef = zero;
+            Add::coef_dict_add_term(outArg(coef), d, one, it->second);
+            changed = true;
+        }
+    }
+    for (const auto &p: x.dict_) {
+        bool unit = is_a<Integer>(*p.second) and
+            static_cast<const Integer &>(*p.second).is_one();
+        if ((not unit and key_types_[MUL]) or (unit and number_keys_)) {
+            auto it = subs_dict_.find(unit ? p.first :
+                Add::from_dict(zero, {{p.first, p.second}}));
+            if (it != subs_dict_.end()) {
+                Add::coef_dict_add_term(outArg(coef), d, one, it->second);
+                changed = true;
+                continue;
+            }
+        }
+        if (number_keys_) {
+            auto it = subs_dict_.find(p.second);
+            if (it != subs_dict_.end()) {
+                Add::coef_dict_add_term(outArg(coef), d, one,
+                    mul(it->second, apply(p.first)));
+                changed = true;
+                continue;
+            }
+        }
+        RCP<const Basic> t = apply(p.first);
+        if (t.get() != p.first.get()) changed = true;
+        Add::coef_dict_add_term(outArg(coef), d, p.second, t);
+    }
+    if (changed) {
+        result_ = Add::from_dict(coef, std::move(d));
+    } else {
+        result_ = x.rcp_from_this();
+    }
+}
+
+void SubsVisitor::bvisit(const Mul &x)
+{
+    // Follows Mul::subs(): every factor `t**e` is substituted as a Pow. The
+    // Pow is only created if it can match a key, otherwise its base and
+    // exponent are substituted directly.
+    RCP<const Number> coef = x.coef_;
+    map_basic_basic d;
+    bool changed = false;
+    for (const auto &p: x.dict_) {
+        RCP<const Basic> factor;
+        bool same;
+        if (eq(*p.second, *one)) {
+            factor = apply(p.first);
+            same = factor.get() == p.first.get();
+        } else if (key_types_[POW]) {
+            RCP<const Basic> factor_old
+                = Mul::from_dict(one, {{p.first, p.second}});
+            factor = apply(factor_old);
+            same = factor.get() == factor_old.get();
+        } else {
+            RCP<const Basic> base = apply(p.first);
+            RCP<const Basic> exp = apply(p.second);
+            same = base.get() == p.first.get() and exp.get() == p.second.get();
+            if (not same) factor = pow(base, exp);
+        }
+        if (same) {
+            Mul::dict_add_term_new(outArg(coef), d, p.second, p.first);
+            continue;
+        }
+        changed = true;
+        if (is_a_Number(*factor)) {
+            if (rcp_static_cast<const Number>(factor)->is_zero()) {
+                result_ = factor;
+                return;
+            }
+            imulnum(outArg(coef), rcp_static_cast<const Number>(factor));
+        } else if (is_a<Mul>(*factor)) {
+            RCP<const Mul> tmp = rcp_static_cast<const Mul>(factor);
+            imulnum(outArg(coef), tmp->coef_);
+            for (const auto &q: tmp->dict_) {
+                Mul::dict_add_term_new(outArg(coef), d, q.second, q.first);
+            }
+        } else {
+            RCP<const Basic> exp, t;
+            Mul::as_base_exp(factor, outArg(exp), outArg(t));
+            Mul::dict_add_term_new(outArg(coef), d, exp, t);
+        }
+    }
+    if (changed) {
+        result_ = Mul::from_dict(coef, std::move(d));
+    } else {
+        result_ = x.rcp_from_this();
+    }
+}
+
+void SubsVisitor::bvisit(const Pow &x)
+{
+    RCP<const Basic> base = apply(x.get_base());
+    RCP<const Basic> exp = apply(x.get_exp());
+    if (base.get() == x.get_base().get() and exp.get() == x.get_exp().get()) {
+        result_ = x.rcp_from_this();
+    } else {
+        result_ = pow(base, exp);
+    }
+}
+
+void SubsVisitor::bvisit(const FunctionSymbol &x)
+{
+    // The arguments go through apply(), so that they share the cache
+    vec_basic v = x.get_args();
+    bool changed = false;
+    for (auto &elem: v) {
+        RCP<const Basic> t = apply(elem);
+        if (t.get() != elem.get()) {
+            elem = t;
+            changed = true;
+        }
+    }
+    if (changed) {
+        result_ = x.create(v);
+    } else {
+        result_ = x.rcp_from_this();
+    }
+}
+
+void SubsVisitor::bvisit(const Log &x)
+{
+    RCP<const Basic> arg = apply(x.get_arg());
+    if (arg.get() == x.get_arg().get()) {
+        result_ = x.rcp_from_this();
+    } else {
+        result_ = log(arg);
+    }
+}
+
+void SubsVisitor::bvisit(const TrigFunction &x)
+{
+    RCP<const Basic> arg = apply(x.get_arg());
+    if (arg.get() == x.get_arg().get()) {
+        result_ = x.rcp_from_this();
+    } else {
+        result_ = x.create(arg);
+    }
+}
+
+void SubsVisitor::bvisit(const HyperbolicFunction &x)
+{
+    RCP<const Basic> arg = apply(x.get_arg());
+    if (arg.get() == x.get_arg().get()) {
+        result_ = x.rcp_from_this();
+    } else {
+        result_ = x.create(arg);
+    }
+}
+
+} // SymEngine
@@ -11,8 +11,7 @@ Symbol::Symbol(const std::string &name)
 
 std::size_t Symbol::__hash__() const
 {
-    std::hash<std::string> hash_fn;
-    return hash_fn(name_);
+    return stable_hash<std::string>(name_);
 }
 
 bool Symbol::__eq__(const Basic &o) const
@@ -1,5 +1,7 @@
 #include <cstddef>
 #include <stdexcept>
+#include <mutex>
+#include <vector>
 
 #include <symengine/symengine_rcp.h>
 #include <symengine/utilities/teuchos/Teuchos_RCP.hpp>
@@ -14,6 +16,142 @@ void print_stack_on_segfault()
     Teuchos::print_stack_on_segfault();
 }
 
+#if defined(WITH_SYMENGINE_THREAD_SAFE) and defined(WITH_SYMENGINE_BIASED_REFCOUNT)
+
+namespace {
+
+struct QueuedInstance {
+    const BiasedRefcount *refcount;
+    const void *obj;
+    BiasedRefcount::Deleter del;
+};
+
+//! Records are never freed, as the instances of a thread can outlive it
+struct OwnerRecord : RefcountOwner {
+    std::mutex lock;
+    std::vector<QueuedInstance> queue;
+    bool alive = true;
+};
+
+//! Hands the instances of the thread over to the other threads at exit
+struct OwnerExit {
+    ~OwnerExit();
+};
+
+thread_local OwnerExit owner_exit;
+thread_local bool this_thread_exited = false;
+
+} // anonymous
+
+thread_local RefcountOwner *this_thread_refcount_owner = nullptr;
+RefcountOwner refcount_merged;
+
+//! Merges the instances queued to the owner `o` of the current thread
+static void merge_queue(OwnerRecord *o)
+{
+    std::vector<QueuedInstance> queue;
+    {
+        std::lock_guard<std::mutex> guard(o->lock);
+        queue.swap(o->queue);
+        o->pending.store(false, std::memory_order_relaxed);
+    }
+    for (const auto &q: queue) {
+        if (q.refcount->merge(true)) q.del(q.obj);
+    }
+}
+
+RefcountOwner *refcount_owner_slow()
+{
+    OwnerRecord *o = static_cast<OwnerRecord *>(this_thread_refcount_owner);
+    if (o == nullptr) {
+        if (this_thread_exited) return &refcount_merged;
+        o = new OwnerRecord();
+        o->pending.store(false, std::memory_order_relaxed);
+        this_thread_refcount_owner = o;
+        // Registers the destructor of the thread local
+        (void)&owner_exit;
+        return o;
+    }
+    merge_queue(o);
+    return o;
+}
+
+OwnerExit::~OwnerExit()
+{
+    OwnerRecord *o = static_cast<OwnerRecord *>(this_thread_refcount_owner);
+    this_thread_refcount_owner = nullptr;
+    this_thread_exited = true;
+    if (o == nullptr) return;
+    std::vector<QueuedInstance> dead;
+    {
+        // From now on the counts of the instances of the thread are only
+        // merged under the lock
+        std::lock_guard<std::mutex> guard(o->lock);
+        o->alive = false;
+        for (const auto &q: o->queue) {
+            if (q.refcount->merge(true)) dead.push_back(q);
+        }
+        o->queue.clear();
+        o->pending.store(false, std::memory_order_relaxed);
+    }
+    // Deleting instances releases others, which can lock other records
+    for (const auto &q: dead) q.del(q.obj);
+}
+
+bool BiasedRefcount::merge(bool dequeue) const
+{
+    return merge_shared(dequeue) == merged_bit;
+}
+
+int BiasedRefcount::merge_shared(bool dequeue) const
+{
+    int delta = static_cast<int>(local_) * unit;
+    local_ = 0;
+    if (dequeue) delta -= queued_bit;
+    if (owner_.load(std::memory_order_relaxed) != &refcount_merged) {
+        delta += merged_bit;
+        owner_.store(&refcount_merged, std::memory_order_relaxed);
+    }
+    return shared_.fetch_add(delta, std::memory_order_acq_rel) + delta;
+}
+
+bool BiasedRefcount::release_owned() const
+{
+    int s = merge_shared(false);
+    if (s == merged_bit) return true;
+    // The last reference is gone, but the instance waits in the queue of
+    // this thread because another thread dropped the shared count to zero
+    // before. Merging the queue now frees it without waiting for the next
+    // instance to be created.
+    if (s == (merged_bit | queued_bit))
+        merge_queue(static_cast<OwnerRecord *>(this_thread_refcount_owner));
+    return false;
+}
+
+bool BiasedRefcount::enqueue(const void *obj, Deleter del) const
+{
+    // A merge in progress accounts for the decrement already done
+    RefcountOwner *owner = owner_.load(std::memory_order_acquire);
+    if (owner == &refcount_merged) return false;
+    int s = shared_.load(std::memory_order_relaxed);
+    do {
+        // Merged or queued by another thread in the meantime, or someone
+        // else took a reference and will release it
+        if ((s & (merged_bit | queued_bit)) or s > 0) return false;
+    } while (not shared_.compare_exchange_weak(s, s | queued_bit,
+                std::memory_order_acq_rel, std::memory_order_relaxed));
+    OwnerRecord *o = static_cast<OwnerRecord *>(owner);
+    std::lock_guard<std::mutex> guard(o->lock);
+    if (o->alive) {
+        o->queue.push_back({this, obj, del});
+        o->pending.store(true, std::memory_order_relaxed);
+        return false;
+    }
+    return merge(true);
+}
+
+#endif // WITH_SYMENGINE_BIASED_REFCOUNT
+
 #endif
 
 } // SymEngine
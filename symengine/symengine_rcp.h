@@ -25,6 +25,13 @@
 
 #endif
 
+// Defined if RCPs shared between threads can be copied and released
+// concurrently. The reference counts of Teuchos::RCP, used in Debug builds,
+// are never thread safe.
+#if defined(WITH_SYMENGINE_RCP) and defined(WITH_SYMENGINE_THREAD_SAFE)
+#define SYMENGINE_RCP_THREAD_SAFE
+#endif
+
 namespace SymEngine {
 
 
@@ -63,6 +70,117 @@ Ptr<T> outArg( T& arg )
     return Ptr<T>(&arg);
 }
 
+#if defined(WITH_SYMENGINE_THREAD_SAFE) and defined(WITH_SYMENGINE_BIASED_REFCOUNT)
+
+/* BiasedRefcount */
+
+struct RefcountOwner;
+
+//! The owner record of the current thread, nullptr until the thread creates
+//! its first instance
+extern thread_local RefcountOwner *this_thread_refcount_owner;
+
+//! Owner of the instances whose counts are merged
+extern RefcountOwner refcount_merged;
+
+//! Creates the owner record of the current thread or merges its queue
+RefcountOwner *refcount_owner_slow();
+
+//! The thread that creates an instance is its owner
+struct RefcountOwner {
+    //! Instances are waiting in the queue of the owner
+    std::atomic<bool> pending;
+};
+
+inline RefcountOwner *refcount_owner()
+{
+    RefcountOwner *o = this_thread_refcount_owner;
+    if (o == nullptr or o->pending.load(std::memory_order_relaxed))
+        o = refcount_owner_slow();
+    return o;
+}
+
+/*! Thread safe reference count where the thread that created the instance
+    (the owner) uses a plain counter, and only the other threads use atomic
+    operations on a second, shared counter. As most copies are made by the
+    owner, the hot paths of a single thread do not pay for locked
+    instructions.
+
+    When the plain counter drops to zero it is merged into the shared one and
+    from then on all threads use the shared counter. The shared counter alone
+    can drop to zero or below, when another thread releases copies made by
+    the owner. The instance is then queued to the owner, who merges it the
+    next time it creates an instance, so until then it is not freed. After
+    the owner exited, the other threads merge its instances themselves.
+*/
+class BiasedRefcount {
+public:
+    typedef void (*Deleter)(const void *);
+
+    BiasedRefcount() : local_(0), shared_(0), owner_(refcount_owner()) {
+        // Instances created by a thread after it exited start merged
+        if (owner_.load(std::memory_order_relaxed) == &refcount_merged)
+            shared_.store(merged_bit, std::memory_order_relaxed);
+    }
+
+    inline void increment() const {
+        if (owner_.load(std::memory_order_relaxed)
+                == this_thread_refcount_owner) {
+            local_++;
+        } else {
+            shared_.fetch_add(unit, std::memory_order_relaxed);
+        }
+    }
+
+    //! \return true if the instance `obj` must be deleted. `del` is kept
+    //! with `obj` if it is queued, for the owner to delete it.
+    inline bool decrement(const void *obj, Deleter del) const {
+        if (owner_.load(std::memory_order_relaxed)
+                == this_thread_refcount_owner) {
+            if (--local_ != 0) return false;
+            return release_owned();
+        }
+        int s = shared_.fetch_sub(unit, std::memory_order_acq_rel) - unit;
+        if (s & merged_bit) return s == merged_bit;
+        // The owner also has to merge a count that drops to zero, as the
+        // first references might have been made by other threads
+        if (s > 0 or (s & queued_bit)) return false;
+        return enqueue(obj, del);
+    }
+
+    //! \return the number of references, only exact if no other thread
+    //! changes it at the same time
+    unsigned int count() const {
+        int s = shared_.load(std::memory_order_relaxed);
+        return local_ + (s - (s & (unit - 1))) / unit;
+    }
+
+    /*! Merges the counters and sets the owner to `refcount_merged`. Only
+        called by the owner, or for an owner that exited under the lock of
+        its record. `dequeue` clears the queued flag.
+        \return true if the instance must be deleted */
+    bool merge(bool dequeue) const;
+
+private:
+    //! The shared counter holds the count times `unit` plus the flags. The
+    //! plain counter packs with it, the shared one then counts up to 2^29
+    //! references held by other threads.
+    static const int merged_bit = 1;
+    static const int queued_bit = 2;
+    static const int unit = 4;
+
+    mutable unsigned int local_;
+    mutable std::atomic<int> shared_;
+    mutable std::atomic<RefcountOwner *> owner_;
+
+    bool enqueue(const void *obj, Deleter del) const;
+    bool release_owned() const;
+    //! Merges and \return the shared counter
+    int merge_shared(bool dequeue) const;
+};
+
+#endif
+
 /* RCP */
 
 enum ENull { null };
@@ -75,15 +193,15 @@ public:
     RCP(ENull null_arg = null) : ptr_(nullptr) {}
     explicit RCP(T *p) : ptr_(p) {
         SYMENGINE_ASSERT(ptr_ != nullptr)
-        (ptr_->refcount_)++;
+        ptr_->increment_refcount();
     }
     // Copy constructor
     RCP(const RCP<T> &rp) : ptr_(rp.ptr_) {
-        if (not is_null()) (ptr_->refcount_)++;
+        if (not is_null()) ptr_->increment_refcount();
     }
     // Copy constructor
     template<class T2> RCP(const RCP<T2>& r_ptr) : ptr_(r_ptr.get()) {
-        if (not is_null()) (ptr_->refcount_)++;
+        if (not is_null()) ptr_->increment_refcount();
     }
     // Move constructor
     RCP(RCP<T> &&rp) : ptr_(rp.ptr_) {
@@ -94,7 +212,7 @@ public:
         r_ptr._set_null();
     }
     ~RCP() {
-        if (ptr_ != nullptr and --(ptr_->refcount_) == 0) delete ptr_;
+        if (ptr_ != nullptr and ptr_->decrement_refcount()) delete ptr_;
     }
     T* operator->() const {
         SYMENGINE_ASSERT(ptr_ != nullptr)
@@ -116,8 +234,8 @@ public:
     // Copy assignment
     RCP<T>& operator=(const RCP<T> &r_ptr) {
         T *r_ptr_ptr_ = r_ptr.ptr_;
-        if (not r_ptr.is_null()) (r_ptr_ptr_->refcount_)++;
-        if (not is_null() and --(ptr_->refcount_) == 0) delete ptr_;
+        if (not r_ptr.is_null()) r_ptr_ptr_->increment_refcount();
+        if (not is_null() and ptr_->decrement_refcount()) delete ptr_;
         ptr_ = r_ptr_ptr_;
         return *this;
     }
@@ -127,7 +245,7 @@ public:
         return *this;
     }
     void reset() {
-        if (not is_null() and --(ptr_->refcount_) == 0) delete ptr_;
+        if (not is_null() and ptr_->decrement_refcount()) delete ptr_;
         ptr_ = nullptr;
     }
     // Don't use this function directly:
@@ -237,8 +355,30 @@ public:
 #endif
     }
 
+    //! Get RCP<const T> pointer to self, or a null RCP if the last reference
+    //! is already gone and the instance is being destroyed
+    inline RCP<const T> rcp_from_this_if_alive() const {
+#if defined(WITH_SYMENGINE_RCP) and defined(WITH_SYMENGINE_THREAD_SAFE) \
+    and not defined(WITH_SYMENGINE_BIASED_REFCOUNT)
+        // Another thread may release the last reference at any time
+        unsigned int n = refcount_.load();
+        do {
+            if (n == 0) return null;
+        } while (not refcount_.compare_exchange_weak(n, n + 1));
+        RCP<const T> p = rcp(static_cast<const T*>(this));
+        --refcount_;
+        return p;
+#else
+        if (use_count() == 0) return null;
+        return rcp_from_this();
+#endif
+    }
+
     unsigned int use_count() const {
-#if defined(WITH_SYMENGINE_RCP)
+#if defined(WITH_SYMENGINE_RCP) and defined(WITH_SYMENGINE_BIASED_REFCOUNT) \
+    and defined(WITH_SYMENGINE_THREAD_SAFE)
+        return refcount_.count();
+#elif defined(WITH_SYMENGINE_RCP)
         return refcount_;
 #else
         return weak_self_ptr_.strong_count();
@@ -259,14 +399,34 @@ private:
     // The refcount_ is defined as mutable, because it does not change the
     // state of the instance, but changes when more copies
     // of the same instance are made.
-#  if defined(WITH_SYMENGINE_THREAD_SAFE)
-    mutable std::atomic<unsigned int> refcount_; // reference counter
+    // With WITH_SYMENGINE_BIASED_REFCOUNT the thread safe counter is a
+    // BiasedRefcount instead, which avoids atomics in the creating thread.
+#  if defined(WITH_SYMENGINE_THREAD_SAFE) and defined(WITH_SYMENGINE_BIASED_REFCOUNT)
+    BiasedRefcount refcount_; // reference counter
+public:
+    EnableRCPFromThis() {}
+private:
+    inline void increment_refcount() const { refcount_.increment(); }
+    inline bool decrement_refcount() const {
+        return refcount_.decrement(this, &delete_this);
+    }
+    static void delete_this(const void *p) {
+        delete static_cast<const T *>(
+            static_cast<const EnableRCPFromThis<T> *>(p));
+    }
 #  else
+#    if defined(WITH_SYMENGINE_THREAD_SAFE)
+    mutable std::atomic<unsigned int> refcount_; // reference counter
+#    else
     mutable unsigned int refcount_; // reference counter
-#  endif // WITH_SYMENGINE_THREAD_SAFE
+#    endif // WITH_SYMENGINE_THREAD_SAFE
 public:
     EnableRCPFromThis() : refcount_(0) {}
 private:
+    inline void increment_refcount() const { refcount_++; }
+    //! \return true if the last reference is gone
+    inline bool decrement_refcount() const { return --refcount_ == 0; }
+#  endif
 
 #else
     mutable RCP<T> weak_self_ptr_;
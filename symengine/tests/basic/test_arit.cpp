@@ -313,6 +313,55 @@ TEST_CASE("Sub: arit", "[arit]")
     REQUIRE(std::abs(rcp_static_cast<const ComplexDouble>(r2)->i.imag() + 1.4) < 1e-12);
 }
 
+TEST_CASE("AddBuilder, MulBuilder: arit", "[arit]")
+{
+    RCP<const Basic> x = symbol("x");
+    RCP<const Basic> y = symbol("y");
+    RCP<const Basic> z = symbol("z");
+    RCP<const Basic> r1, r2;
+
+    r1 = add({x, integer(2), mul(integer(3), y), sub(z, x), y});
+    r2 = add(add(integer(2), mul(integer(4), y)), z);
+    REQUIRE(eq(*r1, *r2));
+    REQUIRE(eq(*add({}), *zero));
+    REQUIRE(eq(*add({x}), *x));
+    REQUIRE(eq(*add({x, mul(integer(-1), x)}), *zero));
+
+    r1 = mul({x, integer(2), pow(y, integer(2)), div(x, y), integer(3)});
+    r2 = mul(integer(6), mul(pow(x, integer(2)), y));
+    REQUIRE(eq(*r1, *r2));
+    REQUIRE(eq(*mul({}), *one));
+    REQUIRE(eq(*mul({x, div(one, x)}), *one));
+
+    // The dictionary of an Add referenced elsewhere must not be stolen
+    RCP<const Basic> s = add(x, y), s2 = s;
+    SymEngine::AddBuilder b(std::move(s2));
+#if defined(WITH_SYMENGINE_RCP)
+    // Teuchos::RCP has no move constructor
+    REQUIRE(s2.is_null());
+#endif
+    b.add_term(z);
+    b.add_term(mul(integer(-1), y));
+    REQUIRE(eq(*b.finish(), *add(x, z)));
+    REQUIRE(eq(*s, *add(x, y)));
+    REQUIRE(eq(*b.finish(), *zero));
+
+    // The only reference: the builder reuses the dictionary
+    SymEngine::AddBuilder b2(std::move(s));
+    b2.add_term(x);
+    REQUIRE(eq(*b2.finish(), *add(mul(integer(2), x), y)));
+
+    RCP<const Basic> m = mul(x, y), m2 = m;
+    SymEngine::MulBuilder c(std::move(m2));
+    c.mul_term(div(integer(3), y));
+    c.mul_term(z);
+    REQUIRE(eq(*c.finish(), *mul(integer(3), mul(x, z))));
+    REQUIRE(eq(*m, *mul(x, y)));
+    SymEngine::MulBuilder c2(std::move(m));
+    c2.mul_term(x);
+    REQUIRE(eq(*c2.finish(), *mul(pow(x, integer(2)), y)));
+}
+
 TEST_CASE("Div: arit", "[arit]")
 {
     RCP<const Basic> x = symbol("x");
@@ -1002,3 +1051,30 @@ TEST_CASE("Expand3: arit", "[arit]")
         << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
         << "ms" << std::endl;
 }
+
+TEST_CASE("Expand4: arit", "[arit]")
+{
+    // Large enough for expand() to split the work over the OpenMP threads
+    // with WITH_SYMENGINE_PARALLEL_EXPAND, compared against products of small
+    // sizes that are expanded serially
+    RCP<const Basic> x = symbol("x");
+    RCP<const Basic> y = symbol("y");
+    RCP<const Basic> z = symbol("z");
+    RCP<const Basic> w = symbol("w");
+    RCP<const Basic> s = add(add(add(add(x, y), z), w), integer(3));
+
+    RCP<const Basic> r = s;
+    for (int i = 1; i < 10; i++)
+        r = expand(mul(r, s));
+    REQUIRE(rcp_dynamic_cast<const Add>(r)->dict_.size() == 1000);
+
+    // Multinomial coefficients
+    REQUIRE(eq(*expand(pow(s, integer(10))), *r));
+    // Product of two sums
+    REQUIRE(eq(*expand(mul(expand(pow(s, integer(4))),
+        expand(pow(s, integer(6))))), *r));
+    // Square of a sum
+    RCP<const Basic> s5 = expand(pow(s, integer(5)));
+    REQUIRE(eq(*expand(pow(s5, integer(2))), *r));
+    REQUIRE(eq(*expand(mul(s5, s5)), *r));
+}
@@ -1,6 +1,8 @@
 #include "catch.hpp"
 #include <cmath>
 #include <iostream>
+#include <thread>
+#include <atomic>
 
 #include <symengine/basic.h>
 #include <symengine/add.h>
@@ -39,6 +41,9 @@ using SymEngine::rcp_static_cast;
 using SymEngine::set_basic;
 using SymEngine::free_symbols;
 using SymEngine::function_symbol;
+using SymEngine::vec_basic;
+using SymEngine::vec_pair;
+using SymEngine::cse;
 
 TEST_CASE("Symbol hash: Basic", "[basic]")
 {
@@ -70,6 +75,26 @@ TEST_CASE("Symbol hash: Basic", "[basic]")
     REQUIRE(seed1 == seed2);
 }
 
+TEST_CASE("Stable hash: Basic", "[basic]")
+{
+    // The hashes, and so the order of map_basic_basic and set_basic, are the
+    // same on all 64 bit platforms
+    if (sizeof(std::size_t) == 8) {
+        REQUIRE(symbol("x")->hash() == 13272411544345499535ULL);
+        REQUIRE(symbol("abcdefghij")->hash() == 18042067762304121004ULL);
+        REQUIRE(SymEngine::stable_hash<double>(0.0)
+            == SymEngine::stable_hash<double>(-0.0));
+    }
+    for (const char *v: {"0", "-7", "9223372036854775807",
+            "-9223372036854775808", "1180591620717411303425",
+            "-1180591620717411303429"}) {
+        mpz_class i(v);
+        long long int bits = SymEngine::mpz_hash_bits(i.get_mpz_t());
+        if (sizeof(long) == 8) REQUIRE(bits == i.get_si());
+        REQUIRE(integer(i)->hash() == static_cast<std::size_t>(bits));
+    }
+}
+
 TEST_CASE("Symbol dict: Basic", "[basic]")
 {
     umap_basic_num d;
@@ -87,6 +112,62 @@ TEST_CASE("Symbol dict: Basic", "[basic]")
     std::cout << *x << std::endl;
 }
 
+// Few distinct hashes, so that the entries form long clusters
+struct CollidingHash {
+    std::size_t operator() (int k) const {
+        return k % 7;
+    }
+};
+
+TEST_CASE("FlatHashMap: Basic", "[basic]")
+{
+    SymEngine::FlatHashMap<int, int, CollidingHash, std::equal_to<int>> m;
+    REQUIRE(m.empty());
+    REQUIRE(m.begin() == m.end());
+    for (int i = 0; i < 300; i++)
+        REQUIRE(m.insert({i, 2 * i}).second);
+    REQUIRE(not m.insert({5, 0}).second);
+    REQUIRE(m.size() == 300);
+    REQUIRE(m.at(5) == 10);
+    CHECK_THROWS_AS(m.at(300), std::out_of_range);
+
+    // Erasing moves entries back in their clusters
+    for (int i = 0; i < 300; i += 3)
+        REQUIRE(m.erase(i) == 1);
+    m.erase(m.find(1));
+    REQUIRE(m.erase(1) == 0);
+    REQUIRE(m.size() == 199);
+    for (int i = 0; i < 300; i++) {
+        bool kept = i % 3 != 0 and i != 1;
+        REQUIRE(m.count(i) == (kept ? 1u : 0u));
+        if (kept) REQUIRE(m.find(i)->second == 2 * i);
+    }
+    std::size_t n = 0;
+    int sum = 0;
+    for (const auto &p: m) {
+        n++;
+        sum += p.first;
+    }
+    REQUIRE(n == m.size());
+    REQUIRE(sum == 44850 - 14850 - 1);
+
+    auto m2 = m;
+    m.clear();
+    REQUIRE(m.empty());
+    REQUIRE(m.find(2) == m.end());
+    REQUIRE(m2.size() == 199);
+    REQUIRE(m2.find(2)->second == 4);
+    m = std::move(m2);
+    REQUIRE(m.size() == 199);
+    REQUIRE(m2.empty());
+
+    umap_basic_num d = {{symbol("x"), integer(2)}, {symbol("y"), one}};
+    d.erase(symbol("x"));
+    REQUIRE(d.size() == 1);
+    REQUIRE(d.find(symbol("x")) == d.end());
+    REQUIRE(eq(*d.find(symbol("y"))->second, *one));
+}
+
 TEST_CASE("Add: basic", "[basic]")
 {
     umap_basic_num m, m2;
@@ -276,6 +357,44 @@ TEST_CASE("Rational: Basic", "[basic]")
     REQUIRE(a == b);
 }
 
+TEST_CASE("Integer and Rational overflow: Basic", "[basic]")
+{
+    RCP<const Number> r1, r2, r3;
+    mpz_class max(LONG_MAX), min(LONG_MIN);
+
+    // The results of the machine integer fast paths overflow into GMP
+    r1 = integer(LONG_MAX);
+    r2 = integer(1);
+    REQUIRE(rcp_static_cast<const Integer>(addnum(r1, r2))->i == max + 1);
+    REQUIRE(rcp_static_cast<const Integer>(mulnum(r1, r1))->i == max * max);
+    r1 = integer(LONG_MIN);
+    REQUIRE(rcp_static_cast<const Integer>(subnum(r1, r2))->i == min - 1);
+    REQUIRE(rcp_static_cast<const Integer>(r1)->neg()->i == -min);
+    REQUIRE(eq(*addnum(integer(max + 1), integer(-1)), *integer(LONG_MAX)));
+    REQUIRE(eq(*integer(ULONG_MAX), *integer(mpz_class(ULONG_MAX))));
+    REQUIRE(eq(*integer(-3), *integer(mpz_class(-3))));
+
+    r1 = Rational::from_two_ints(LONG_MAX, 2);
+    r2 = Rational::from_two_ints(1, 3);
+    r3 = addnum(r1, r2);
+    REQUIRE(rcp_static_cast<const Rational>(r3)->i
+        == mpq_class(max, 2) + mpq_class(1, 3));
+    r3 = mulnum(r1, r1);
+    REQUIRE(rcp_static_cast<const Rational>(r3)->i
+        == mpq_class(max * max, 4));
+    r3 = subnum(r2, integer(LONG_MIN));
+    REQUIRE(rcp_static_cast<const Rational>(r3)->i
+        == mpq_class(1 - 3 * min, 3));
+    r3 = mulnum(r1, integer(2));
+    REQUIRE(eq(*r3, *integer(LONG_MAX)));
+    r3 = mulnum(r2, zero);
+    REQUIRE(eq(*r3, *zero));
+    r3 = addnum(r2, Rational::from_two_ints(-1, 3));
+    REQUIRE(eq(*r3, *zero));
+    REQUIRE(eq(*rcp_static_cast<const Rational>(r2)->neg(),
+        *Rational::from_two_ints(-1, 3)));
+}
+
 TEST_CASE("Mul: Basic", "[basic]")
 {
     map_basic_basic m, m2;
@@ -669,3 +788,209 @@ TEST_CASE("free_symbols: Basic", "[basic]")
     REQUIRE(s.size() == 1);
     REQUIRE(s.count(x) == 1);
 }
+
+//! \return the arguments given by `for_each_arg()`
+static std::multiset<std::string> args_of(const Basic &b)
+{
+    std::multiset<std::string> args;
+    b.for_each_arg([&](const Basic &arg) { args.insert(arg.__str__()); });
+    return args;
+}
+
+TEST_CASE("for_each_arg: Basic", "[basic]")
+{
+    RCP<const Basic> x = symbol("x"), y = symbol("y");
+    RCP<const Basic> r1;
+
+    r1 = add(integer(3), add(mul(integer(2), x), pow(y, integer(2))));
+    REQUIRE(args_of(*r1) == std::multiset<std::string>({"3", "x", "2", "y**2", "1"}));
+    r1 = add(x, y);
+    REQUIRE(args_of(*r1) == std::multiset<std::string>({"x", "1", "y", "1"}));
+
+    r1 = mul(integer(3), mul(x, pow(y, integer(2))));
+    REQUIRE(args_of(*r1) == std::multiset<std::string>({"3", "x", "1", "y", "2"}));
+    r1 = mul(x, y);
+    REQUIRE(args_of(*r1) == std::multiset<std::string>({"x", "1", "y", "1"}));
+
+    r1 = pow(x, y);
+    REQUIRE(args_of(*r1) == std::multiset<std::string>({"x", "y"}));
+    r1 = sin(add(x, y));
+    REQUIRE(args_of(*r1) == std::multiset<std::string>({"x + y"}));
+    r1 = function_symbol("f", {x, y, x});
+    REQUIRE(args_of(*r1) == std::multiset<std::string>({"x", "y", "x"}));
+    REQUIRE(args_of(*x).empty());
+    REQUIRE(args_of(*integer(2)).empty());
+}
+
+//! Substitutes the replacements back, in reverse order, into `reduced`
+static RCP<const Basic> cse_restore(const vec_pair &replacements,
+        const RCP<const Basic> &reduced)
+{
+    RCP<const Basic> r = reduced;
+    for (auto it = replacements.rbegin(); it != replacements.rend(); ++it) {
+        r = r->subs({{it->first, it->second}});
+    }
+    return r;
+}
+
+TEST_CASE("cse: Basic", "[basic]")
+{
+    RCP<const Basic> x, y, z, w, x0, x1, e1, e2, e3;
+    x = symbol("x");
+    y = symbol("y");
+    z = symbol("z");
+    w = symbol("w");
+    x0 = symbol("x0");
+    x1 = symbol("x1");
+    vec_pair replacements;
+    vec_basic reduced;
+
+    e1 = add(pow(add(x, y), integer(2)), sin(add(x, y)));
+    cse(replacements, reduced, {e1});
+    REQUIRE(replacements.size() == 1);
+    REQUIRE(eq(*replacements[0].first, *x0));
+    REQUIRE(eq(*replacements[0].second, *add(x, y)));
+    REQUIRE(reduced.size() == 1);
+    REQUIRE(eq(*reduced[0], *add(pow(x0, integer(2)), sin(x0))));
+
+    // Nothing to eliminate
+    replacements.clear();
+    reduced.clear();
+    cse(replacements, reduced, {add(x, y), sin(z)});
+    REQUIRE(replacements.size() == 0);
+    REQUIRE(eq(*reduced[0], *add(x, y)));
+    REQUIRE(eq(*reduced[1], *sin(z)));
+
+    // Common subsets of the arguments of Add and Mul
+    replacements.clear();
+    reduced.clear();
+    e1 = add(x, add(y, z));
+    e2 = add(x, add(y, w));
+    cse(replacements, reduced, {e1, e2});
+    REQUIRE(replacements.size() == 1);
+    REQUIRE(eq(*replacements[0].second, *add(x, y)));
+    REQUIRE(eq(*reduced[0], *add(replacements[0].first, z)));
+    REQUIRE(eq(*reduced[1], *add(replacements[0].first, w)));
+
+    replacements.clear();
+    reduced.clear();
+    e1 = mul(integer(2), mul(x, mul(y, z)));
+    e2 = mul(x, mul(y, w));
+    e3 = cos(mul(x, y));
+    cse(replacements, reduced, {e1, e2, e3});
+    REQUIRE(replacements.size() == 1);
+    REQUIRE(eq(*replacements[0].second, *mul(x, y)));
+    REQUIRE(eq(*reduced[2], *cos(replacements[0].first)));
+
+    // Nested replacements, and names already in use are skipped
+    replacements.clear();
+    reduced.clear();
+    e1 = sin(add(x0, y));
+    e2 = pow(e1, integer(3));
+    e3 = add(mul(e1, cos(e1)), mul(e2, z));
+    cse(replacements, reduced, {e3, add(e2, x0)});
+    REQUIRE(replacements.size() == 2);
+    for (const auto &p: replacements) REQUIRE(neq(*p.first, *x0));
+    REQUIRE(eq(*cse_restore(replacements, reduced[0]), *e3));
+    REQUIRE(eq(*cse_restore(replacements, reduced[1]), *add(e2, x0)));
+}
+
+TEST_CASE("intern: Basic", "[basic]")
+{
+    RCP<const Basic> x = symbol("x");
+    RCP<const Basic> y = symbol("y");
+    RCP<const Basic> r1, r2, r3;
+
+    r1 = add(pow(x, integer(2)), mul(integer(3), y));
+    r2 = add(mul(y, integer(3)), pow(x, integer(2)));
+    r3 = add(pow(x, integer(2)), mul(integer(2), y));
+    REQUIRE(eq(*r1, *r2));
+    REQUIRE(neq(*r1, *r3));
+
+#if defined(WITH_SYMENGINE_INTERN)
+    // Equal expressions are the same instance
+    REQUIRE(r1.get() == r2.get());
+    REQUIRE(r1->is_interned());
+    REQUIRE(not x->is_interned());
+
+    // Instances are removed from the table once released
+    std::size_t n = SymEngine::intern_table_size();
+    r3 = x;
+    REQUIRE(SymEngine::intern_table_size() < n);
+    r3 = add(pow(x, integer(2)), mul(integer(2), y));
+    REQUIRE(SymEngine::intern_table_size() == n);
+
+    // Instances created directly are not interned but compare equal
+    umap_basic_num d;
+    SymEngine::insert(d, pow(x, integer(2)), one);
+    SymEngine::insert(d, y, integer(3));
+    RCP<const Basic> r4 = make_rcp<const Add>(zero, std::move(d));
+    REQUIRE(not r4->is_interned());
+    REQUIRE(eq(*r1, *r4));
+
+    // Instances interned by another thread compare equal, and are removed
+    // from the table of that thread when released by this one
+    RCP<const Basic> r5, r6;
+    std::thread t([&]() { r5 = add(pow(x, integer(3)), y); });
+    t.join();
+    r6 = add(pow(x, integer(3)), y);
+    REQUIRE(r5->is_interned());
+    REQUIRE(eq(*r5, *r6));
+#if defined(WITH_SYMENGINE_INTERN_GLOBAL)
+    REQUIRE(r5.get() == r6.get());
+#else
+    REQUIRE(r5.get() != r6.get());
+    REQUIRE(not r5->is_interned_with(*r6));
+#endif
+    n = SymEngine::intern_table_size();
+    r5 = x;
+    REQUIRE(SymEngine::intern_table_size() == n);
+
+#if defined(SYMENGINE_RCP_THREAD_SAFE)
+    // Equal instances interned and released concurrently
+    std::vector<std::thread> threads;
+    std::atomic<unsigned> unequal(0);
+    for (unsigned i = 0; i < 4; i++) {
+        threads.emplace_back([&]() {
+            for (unsigned j = 0; j < 1000; j++) {
+                RCP<const Basic> e = add(pow(x, integer(j % 7)), y);
+                if (neq(*e, *add(y, pow(x, integer(j % 7))))) unequal++;
+            }
+        });
+    }
+    for (auto &th: threads) th.join();
+    REQUIRE(unequal == 0);
+    REQUIRE(SymEngine::intern_table_size() == n);
+#endif
+#endif
+}
+
+#if defined(WITH_SYMENGINE_POOL)
+TEST_CASE("BasicArena: Basic", "[basic]")
+{
+    RCP<const Basic> x = symbol("x");
+    RCP<const Basic> y = symbol("y");
+    RCP<const Basic> r1, r2;
+
+    {
+        SymEngine::BasicArena arena;
+        r2 = SymEngine::expand(pow(add(x, y), integer(10)));
+        REQUIRE(arena.size() > 0);
+        {
+            // Temporaries of a nested arena are released with it
+            SymEngine::BasicArena arena2;
+            RCP<const Basic> t = SymEngine::expand(pow(add(x, y), integer(3)));
+            REQUIRE(arena2.size() > 0);
+            t = x;
+            REQUIRE(arena2.size() == 0);
+        }
+        r1 = SymEngine::expand(pow(add(x, y), integer(2)));
+    }
+    // Instances still referenced outlive the arena
+    REQUIRE(eq(*r1, *add(add(pow(x, integer(2)), mul(integer(2), mul(x, y))),
+        pow(y, integer(2)))));
+    REQUIRE(r2->get_args().size() == 11);
+    r2 = SymEngine::expand(mul(r2, r1));
+    REQUIRE(r2->get_args().size() == 13);
+}
+#endif
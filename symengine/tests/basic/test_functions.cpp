@@ -16,6 +16,7 @@
 #include <symengine/real_mpfr.h>
 #include <symengine/complex_mpc.h>
 #include <symengine/eval_double.h>
+#include <symengine/derivative.h>
 
 using SymEngine::Basic;
 using SymEngine::Add;
@@ -930,6 +931,78 @@ TEST_CASE("Derivative: functions", "[functions]")
     REQUIRE(eq(*r2, *r3));
 }
 
+//! A function whose derivative is nonzero with respect to any symbol
+class MyOpaque : public FunctionWrapper {
+public :
+    MyOpaque(RCP<const Basic> arg) : FunctionWrapper("MyOpaque", arg) {
+
+    }
+    RCP<const Number> eval(long bits) const {
+        return real_double(eval_double(*arg_[0]));
+    }
+    RCP<const Basic> create(const vec_basic &v) const {
+        return make_rcp<MyOpaque>(v[0]);
+    }
+    RCP<const Basic> diff_impl(const RCP<const Symbol> &x) const {
+        return function_symbol("dMyOpaque", {arg_[0], x});
+    }
+};
+
+TEST_CASE("DiffCache: functions", "[functions]")
+{
+    RCP<const Symbol> x = symbol("x");
+    RCP<const Symbol> y = symbol("y");
+    RCP<const Symbol> z = symbol("z");
+    RCP<const Basic> i2 = integer(2);
+    RCP<const Basic> f = function_symbol("f", {x, y});
+    RCP<const Basic> g = make_rcp<MyOpaque>(z);
+    RCP<const Basic> r1, r2, r3, r4;
+
+    // Same results as Basic::diff()
+    r1 = add(mul(sin(mul(x, y)), exp(pow(x, i2))), add(f, g));
+    SymEngine::DiffCache c;
+    for (const auto &s: {x, y, z}) {
+        REQUIRE(eq(*c.diff(r1, s), *r1->diff(s)));
+        REQUIRE(eq(*c.diff(r1, s), *r1->diff(s)));
+    }
+    SymEngine::vec_basic gr = c.gradient(r1, {x, y, z});
+    REQUIRE(gr.size() == 3);
+    REQUIRE(eq(*gr[1], *r1->diff(y)));
+    // `g` does not contain `x`, but its derivative is not zero
+    REQUIRE(eq(*gr[0], *r1->diff(x)));
+    REQUIRE(neq(*gr[0], *c.diff(add(mul(sin(mul(x, y)),
+        exp(pow(x, i2))), f), x)));
+
+    SymEngine::vec_basic h = c.hessian(r1, {x, y});
+    REQUIRE(h.size() == 4);
+    REQUIRE(eq(*h[0], *r1->diff(x)->diff(x)));
+    REQUIRE(eq(*h[1], *r1->diff(x)->diff(y)));
+    REQUIRE(eq(*h[2], *h[1]));
+    REQUIRE(eq(*h[3], *r1->diff(y)->diff(y)));
+
+    // A DAG whose tree form has about 2^40 nodes. Its derivative is built by
+    // the chain rule alongside, and compared with Basic::diff() at a depth
+    // where the tree can be walked. Comparing the big ones with eq() would
+    // walk the whole tree, so only their hashes are.
+    r1 = add(x, g);
+    r2 = add(one, function_symbol("dMyOpaque", {z, x}));
+    for (int i = 0; i < 40; i++) {
+        r2 = add(mul(cos(r1), r2), mul(r2, y));
+        r1 = add(sin(r1), mul(r1, y));
+        if (i == 9) {
+            r3 = r1;
+            r4 = r2;
+        }
+    }
+    SymEngine::DiffCache c2;
+    REQUIRE(eq(*c2.diff(r3, x), *r3->diff(x)));
+    REQUIRE(eq(*c2.diff(r3, x), *r4));
+    REQUIRE(c2.diff(r1, x)->hash() == r2->hash());
+    REQUIRE(neq(*c2.diff(r1, symbol("w")), *zero));
+
+    CHECK_THROWS_AS(c.gradient(r1, {x, i2}), std::runtime_error);
+}
+
 TEST_CASE("Subs: functions", "[functions]")
 {
     RCP<const Symbol> x = symbol("x");
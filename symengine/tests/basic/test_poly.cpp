@@ -29,6 +29,8 @@ using SymEngine::vec_int;
 using SymEngine::monomial_mul;
 using SymEngine::poly_mul;
 using SymEngine::umap_vec_mpz;
+using SymEngine::SparsePoly;
+using SymEngine::packed_monomial;
 using SymEngine::RCP;
 using SymEngine::rcp_dynamic_cast;
 using SymEngine::print_stack_on_segfault;
@@ -95,3 +97,82 @@ TEST_CASE("expand: poly", "[poly]")
         << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count()
         << "ms" << std::endl;
 }
+
+TEST_CASE("SparsePoly: poly", "[poly]")
+{
+    RCP<const Basic> x = symbol("x");
+    RCP<const Basic> y = symbol("y");
+    RCP<const Basic> z = symbol("z");
+    RCP<const Basic> w = symbol("w");
+
+    RCP<const Basic> e, f1, f2;
+    e = pow(add(add(add(x, y), z), w), integer(5));
+    f1 = expand(e);
+    f2 = expand(add(e, w));
+
+    umap_basic_num syms;
+    insert(syms, x, integer(0));
+    insert(syms, y, integer(1));
+    insert(syms, z, integer(2));
+    insert(syms, w, integer(3));
+
+    SparsePoly P1, P2, C;
+    expr2poly(f1, syms, P1);
+    expr2poly(f2, syms, P2);
+    REQUIRE(P1.n == 4);
+    REQUIRE(P1.bits == 32);
+    poly_mul(P1, P2, C);
+
+    // Same result as with exponent vectors and as expand()
+    umap_vec_mpz Q1, Q2, D;
+    expr2poly(f1, syms, Q1);
+    expr2poly(f2, syms, Q2);
+    vec_int exp(4, 0);
+    for (const auto &q: Q1) {
+        for (const auto &r: Q2) {
+            SymEngine::monomial_mul(q.first, r.first, exp);
+            D[exp] += q.second * r.second;
+        }
+    }
+    REQUIRE(C.dict.size() == D.size());
+    for (const auto &c: C.dict) {
+        C.unpack(c.first, exp);
+        REQUIRE(D[exp] == c.second);
+    }
+    REQUIRE(C.dict.size() == expand(mul(f1, f2))->get_args().size());
+
+    umap_vec_mpz Q3;
+    poly_mul(Q1, Q2, Q3);
+    REQUIRE(Q3 == D);
+
+    // The heap method gives the same terms, in decreasing order
+    SymEngine::vec_packed_mpz H;
+    SymEngine::poly_mul_heap(P1, P2, H);
+    REQUIRE(H.size() == D.size());
+    for (unsigned i = 0; i < H.size(); i++) {
+        C.unpack(H[i].first, exp);
+        REQUIRE(D[exp] == H[i].second);
+        if (i > 0) REQUIRE(H[i].first < H[i - 1].first);
+    }
+    SparsePoly C2;
+    SymEngine::poly_mul_heap(P2, P1, C2);
+    REQUIRE(C2.dict == C.dict);
+
+    vec_int a = {1, 2, 3, 4};
+    REQUIRE(P1.max_degrees() == vec_int({5, 5, 5, 5}));
+    P1.unpack(P1.pack(a), exp);
+    REQUIRE(exp == a);
+
+    SparsePoly P3(16);
+    REQUIRE(P3.bits == 8);
+    a.assign(16, 0);
+    a[15] = 255;
+    P3.unpack(P3.pack(a), exp);
+    REQUIRE(exp == a);
+    a[15] = 256;
+    CHECK_THROWS_AS(P3.pack(a), std::runtime_error);
+    a[15] = 200;
+    P3.dict[P3.pack(a)] = 1;
+    CHECK_THROWS_AS(poly_mul(P3, P3, C), std::runtime_error);
+    CHECK_THROWS_AS(SparsePoly(33), std::runtime_error);
+}
@@ -21,6 +21,7 @@ using SymEngine::one;
 using SymEngine::zero;
 using SymEngine::integer;
 using SymEngine::vec_basic_eq_perm;
+using SymEngine::DenseUniPoly;
 
 TEST_CASE("Constructor of UnivariatePolynomial", "[UnivariatePolynomial]")
 {
@@ -82,6 +83,14 @@ TEST_CASE("Multiplication of two UnivariatePolynomial", "[UnivariatePolynomial]"
 
     REQUIRE(c->__str__() == "x**4 + 4*x**3 + 6*x**2 + 4*x + 1");
     REQUIRE(d->__str__() == "-x**4 - 4*x**3 - 6*x**2 - 4*x - 1");
+
+    RCP<const UnivariatePolynomial> e = UnivariatePolynomial::create(x, {3, 3});
+    REQUIRE(mul_uni_poly(e, e)->__str__() == "9*x**2 + 18*x + 9");
+    RCP<const UnivariatePolynomial> f = UnivariatePolynomial::create(x, {5, -2, 1});
+    RCP<const UnivariatePolynomial> g = UnivariatePolynomial::create(x, {7, -3});
+    RCP<const UnivariatePolynomial> h = UnivariatePolynomial::create(x, {35, -29, 13, -3});
+    REQUIRE(eq(*mul_uni_poly(f, g), *h));
+    REQUIRE(eq(*mul_uni_poly(g, f), *h));
 }
 
 TEST_CASE("UnivariatePolynomial get_args", "[UnivariatePolynomial]")
@@ -100,6 +109,11 @@ TEST_CASE("Evaluation of UnivariatePolynomial", "[UnivariatePolynomial]")
 
     REQUIRE(a->eval(2) == 9);
     REQUIRE(a->eval_bit(3) == 81);
+
+    // Overlapping terms and negative coefficients
+    RCP<const UnivariatePolynomial> b = univariate_polynomial(x, 3, {{0, 5}, {1, -2}, {3, mpz_class("-18446744073709551617")}});
+    REQUIRE(b->eval_bit(1) == mpz_class("-147573952589676412935"));
+    REQUIRE(b->eval_bit(70) == b->eval(mpz_class(1) << 70));
 }
 
 TEST_CASE("Derivative of UnivariatePolynomial", "[UnivariatePolynomial]")
@@ -159,3 +173,85 @@ TEST_CASE("Univariate Polynomial expand", "[UnivariatePolynomial][expand]")
     REQUIRE(c->__str__() == "x**9 + 3*x**8 + 6*x**7 + 7*x**6 + 6*x**5 + 3*x**4 + x**3");
     //std::cout<<c->__str__()<<std::endl;
 }
+
+//! \return a polynomial of length `n` with coefficients of about `bits` bits
+//! and of both signs, some of them zero
+static DenseUniPoly random_dense(gmp_randclass &r, unsigned n, unsigned bits)
+{
+    std::vector<mpz_class> c(n);
+    for (unsigned i = 0; i < n; i++) {
+        if (i % 7 == 3) continue;
+        c[i] = r.get_z_bits(bits) + 1;
+        if (i % 3 == 1) c[i] = -c[i];
+    }
+    return DenseUniPoly(std::move(c));
+}
+
+TEST_CASE("DenseUniPoly conversions", "[DenseUniPoly]")
+{
+    RCP<const Symbol> x  = symbol("x");
+    RCP<const UnivariatePolynomial> a = univariate_polynomial(x, 3, {{0, -1}, {3, 2}});
+    DenseUniPoly A(*a);
+    REQUIRE(A.degree() == 3);
+    REQUIRE(A.c == std::vector<mpz_class>({-1, 0, 0, 2}));
+    REQUIRE(eq(*A.as_basic(x), *a));
+
+    DenseUniPoly Z(std::vector<mpz_class>({0, 0}));
+    REQUIRE(Z.degree() == -1);
+    REQUIRE(eq(*Z.as_basic(x), *zero));
+    REQUIRE(Z == DenseUniPoly(*univariate_polynomial(x, 0, {{0, 0}})));
+
+    DenseUniPoly C;
+    poly_mul(A, Z, C);
+    REQUIRE(C == Z);
+    poly_mul_kronecker(Z, A, C);
+    REQUIRE(C == Z);
+    poly_mul(A, A, C);
+    REQUIRE(C.c == std::vector<mpz_class>({1, 0, 0, -4, 0, 0, 4}));
+}
+
+TEST_CASE("DenseUniPoly multiplication", "[DenseUniPoly]")
+{
+    gmp_randclass r(gmp_randinit_default);
+    r.seed(42);
+    DenseUniPoly A, B, C, D;
+    for (unsigned bits : {1, 20, 40, 64, 200}) {
+        for (unsigned na : {1, 2, 15, 16, 33, 70, 150}) {
+            for (unsigned nb : {1, 5, 17, 64, 150}) {
+                A = random_dense(r, na, bits);
+                B = random_dense(r, nb, bits + 7);
+                poly_mul_schoolbook(A, B, C);
+                REQUIRE(C.degree() == A.degree() + B.degree());
+                poly_mul_karatsuba(A, B, D);
+                REQUIRE(C == D);
+                poly_mul_kronecker(A, B, D);
+                REQUIRE(C == D);
+                poly_mul(A, B, D);
+                REQUIRE(C == D);
+            }
+        }
+        // mul_uni_poly with the same coefficients
+        RCP<const Symbol> x = symbol("x");
+        RCP<const UnivariatePolynomial> pa = UnivariatePolynomial::create(x, A.c);
+        RCP<const UnivariatePolynomial> pb = UnivariatePolynomial::create(x, B.c);
+        REQUIRE(C == DenseUniPoly(*mul_uni_poly(pa, pb)));
+
+        // Squaring, and the product stored in a factor
+        A = random_dense(r, 100, bits);
+        poly_mul_schoolbook(A, A, C);
+        poly_mul_kronecker(A, A, D);
+        REQUIRE(C == D);
+        poly_mul(A, A, A);
+        REQUIRE(C == A);
+    }
+
+    // Coefficients cancelling to zero, and carries across the fields
+    A = DenseUniPoly(std::vector<mpz_class>({1, 1}));
+    B = DenseUniPoly(std::vector<mpz_class>({-1, 1}));
+    poly_mul_kronecker(A, B, C);
+    REQUIRE(C.c == std::vector<mpz_class>({-1, 0, 1}));
+    A = DenseUniPoly(std::vector<mpz_class>({-255, 255, -255, 255}));
+    poly_mul_schoolbook(A, A, C);
+    poly_mul_kronecker(A, A, D);
+    REQUIRE(C == D);
+}
@@ -12,6 +12,7 @@
 #include <symengine/functions.h>
 #include <symengine/constants.h>
 #include <symengine/real_double.h>
+#include <symengine/visitor.h>
 
 using SymEngine::Basic;
 using SymEngine::Add;
@@ -27,6 +28,7 @@ using SymEngine::multinomial_coefficients;
 using SymEngine::one;
 using SymEngine::zero;
 using SymEngine::sin;
+using SymEngine::function_symbol;
 using SymEngine::RCP;
 using SymEngine::rcp_dynamic_cast;
 using SymEngine::map_basic_basic;
@@ -226,3 +228,68 @@ TEST_CASE("Trig: subs", "[subs]")
     r2 = mul(i2, z);
     REQUIRE(eq(*r1->subs(d), *r2));
 }
+
+TEST_CASE("SubsVisitor: subs", "[subs]")
+{
+    RCP<const Basic> x = symbol("x");
+    RCP<const Basic> y = symbol("y");
+    RCP<const Basic> z = symbol("z");
+    RCP<const Basic> i2 = integer(2);
+
+    // DAGs whose tree forms have about 2^10 and 2^40 nodes. Comparing the
+    // big ones with eq() would walk the whole tree, so only their hashes are.
+    RCP<const Basic> r1 = x, r2 = z, r5, r6;
+    for (int i = 0; i < 40; i++) {
+        r1 = add(sin(r1), mul(pow(r1, i2), y));
+        r2 = add(sin(r2), mul(pow(r2, i2), y));
+        if (i == 9) {
+            r5 = r1;
+            r6 = r2;
+        }
+    }
+    map_basic_basic d;
+    d[x] = z;
+    SymEngine::SubsVisitor s(d);
+    REQUIRE(eq(*s.apply(r5), *r6));
+    REQUIRE(eq(*r5->subs(d), *r6));
+    REQUIRE(s.apply(r1)->hash() == r2->hash());
+    REQUIRE(r1->subs(d)->hash() == r2->hash());
+
+    // Unchanged subtrees are returned as they are
+    RCP<const Basic> r3 = add(r5, mul(y, sin(y)));
+    REQUIRE(eq(*s.apply(r3), *add(r6, mul(y, sin(y)))));
+    RCP<const Basic> r4 = mul(y, sin(y));
+    REQUIRE(SymEngine::SubsVisitor(d).apply(r4).get() == r4.get());
+
+    // Terms and factors matching keys of the dictionary as a whole
+    d.clear();
+    d[mul(i2, x)] = z;
+    d[pow(y, i2)] = x;
+    d[integer(3)] = y;
+    SymEngine::SubsVisitor s2(d);
+    r1 = add(add(mul(i2, x), mul(integer(3), y)), sin(mul(x, pow(y, i2))));
+    r2 = add(add(z, pow(y, i2)), sin(pow(x, i2)));
+    REQUIRE(eq(*s2.apply(r1), *r2));
+    s2.clear_cache();
+    REQUIRE(eq(*s2.apply(r1), *r2));
+
+    // Arguments of function symbols share the cache, `f(x+y) + g(x+y)`
+    // nested 40 times would take 2^40 substitutions otherwise
+    d.clear();
+    d[x] = z;
+    r1 = add(x, y);
+    r2 = add(z, y);
+    for (int i = 0; i < 40; i++) {
+        r1 = add(function_symbol("f", r1), function_symbol("g", r1));
+        r2 = add(function_symbol("f", r2), function_symbol("g", r2));
+        if (i == 9) {
+            r5 = r1;
+            r6 = r2;
+        }
+    }
+    REQUIRE(eq(*r5->subs(d), *r6));
+    REQUIRE(r1->subs(d)->hash() == r2->hash());
+    r3 = function_symbol("f", r1);
+    REQUIRE(SymEngine::SubsVisitor(d).apply(r3)->hash()
+        == function_symbol("f", r2)->hash());
+}
@@ -1,6 +1,10 @@
 #include "catch.hpp"
+#include <limits>
 
 #include <symengine/lambda_double.h>
+#include <symengine/lambda_bytecode.h>
+#include <symengine/lambda_jit.h>
+#include <symengine/matrix.h>
 
 using SymEngine::Basic;
 using SymEngine::RCP;
@@ -14,6 +18,20 @@ using SymEngine::vec_basic;
 using SymEngine::complex_double;
 using SymEngine::LambdaRealDoubleVisitor;
 using SymEngine::LambdaComplexDoubleVisitor;
+using SymEngine::LambdaRealDoubleBytecode;
+using SymEngine::sin;
+using SymEngine::cos;
+using SymEngine::div;
+using SymEngine::sqrt;
+using SymEngine::exp;
+using SymEngine::log;
+using SymEngine::atan2;
+using SymEngine::gamma;
+using SymEngine::sub;
+using SymEngine::pi;
+using SymEngine::E;
+using SymEngine::DenseMatrix;
+using SymEngine::LambdaRealDoubleJIT;
 
 TEST_CASE("Evaluate to double", "[lambda_double]")
 {
@@ -66,3 +84,224 @@ TEST_CASE("Evaluate to std::complex<double>", "[lambda_complex_double]")
     // Undefined symbols raise an exception
     CHECK_THROWS_AS(v.init({x}, *r), std::runtime_error);
 }
+
+TEST_CASE("Evaluate to double using bytecode", "[lambda_bytecode]")
+{
+    RCP<const Basic> x, y, z, r, s;
+    double d;
+    x = symbol("x");
+    y = symbol("y");
+    z = symbol("z");
+
+    r = add(x, add(mul(y, z), pow(x, integer(2))));
+
+    LambdaRealDoubleBytecode v;
+    v.init({x, y, z}, *r);
+
+    d = v.call({1.5, 2.0, 3.0});
+    REQUIRE(::fabs(d - 9.75) < 1e-12);
+
+    d = v.call({1.5, -1.0, 2.0});
+    REQUIRE(::fabs(d - 1.75) < 1e-12);
+
+    // The result must agree with the closure based visitor
+    s = sin(add(mul(x, y), integer(1)));
+    r = add(div(pow(s, integer(3)), sub(z, sqrt(x))),
+        mul(exp(s), add(log(x), pow(y, div(integer(-3), integer(2))))));
+    r = add(r, add(atan2(y, x), add(gamma(z), mul(pi, E))));
+    r = add(r, mul(integer(-2), pow(x, integer(-5))));
+    LambdaRealDoubleVisitor v2;
+    v2.init({x, y, z}, *r);
+    v.init({x, y, z}, *r);
+    for (double t = 0.5; t < 3; t += 0.25) {
+        std::vector<double> p = {t, t + 0.75, 3.5 - t};
+        d = v2.call(p);
+        REQUIRE(::fabs(v.call(p) - d) < 1e-12 * std::max(1.0, ::fabs(d)));
+    }
+
+    // The repeated subtree `s` is computed once
+    r = add(mul(s, s), add(mul(sin(s), s), mul(cos(s), sin(s))));
+    v.init({x, y}, *r);
+    unsigned n_sin = 0;
+    for (const auto &i: v.get_code()) {
+        if (i.op == SymEngine::BytecodeOp::Sin) n_sin++;
+    }
+    REQUIRE(n_sin == 2);
+
+    // Constant subexpressions are folded
+    v.init({x}, *add(x, sin(add(pi, integer(2)))));
+    REQUIRE(v.get_code().size() == 1);
+    REQUIRE(::fabs(v.call({1.0}) - (1.0 + std::sin(M_PI + 2))) < 1e-12);
+
+    v.init({x}, *integer(3));
+    REQUIRE(v.get_code().size() == 0);
+    REQUIRE(::fabs(v.call({1.0}) - 3.0) < 1e-12);
+
+    // Evaluating to double when there are complex doubles raise an exception
+    CHECK_THROWS_AS(v.init({x}, *add(complex_double(std::complex<double>(1, 2)), x)), std::runtime_error);
+
+    // Undefined symbols raise an exception
+    CHECK_THROWS_AS(v.init({x}, *add(x, y)), std::runtime_error);
+}
+
+TEST_CASE("Batch evaluate to double using bytecode", "[lambda_bytecode]")
+{
+    RCP<const Basic> x, y, r;
+    x = symbol("x");
+    y = symbol("y");
+    r = add(mul(sin(x), pow(y, integer(3))), div(exp(x), add(y, integer(2))));
+
+    LambdaRealDoubleBytecode v;
+    v.init({x, y}, *r);
+
+    // More points than one block, so that the last block is partial
+    const std::size_t n = LambdaRealDoubleBytecode::batch_size * 2 + 17;
+    std::vector<double> xs(n), ys(n), out(n);
+    for (std::size_t k = 0; k < n; k++) {
+        xs[k] = 0.01 * k;
+        ys[k] = 1.0 - 0.003 * k;
+    }
+    const double *inputs[] = {xs.data(), ys.data()};
+    v.call_batch(inputs, out.data(), n);
+    for (std::size_t k = 0; k < n; k++) {
+        double d = v.call({xs[k], ys[k]});
+        REQUIRE(::fabs(out[k] - d) < 1e-12 * std::max(1.0, ::fabs(d)));
+    }
+
+    // Constant expressions are broadcast
+    v.init({x, y}, *integer(5));
+    v.call_batch(inputs, out.data(), 3);
+    REQUIRE(::fabs(out[2] - 5.0) < 1e-12);
+}
+
+TEST_CASE("Evaluate several expressions using bytecode", "[lambda_bytecode]")
+{
+    RCP<const Basic> x, y, z, s;
+    x = symbol("x");
+    y = symbol("y");
+    z = symbol("z");
+    s = sin(add(mul(x, y), z));
+
+    DenseMatrix A = DenseMatrix(3, 1, {mul(s, x), add(pow(s, integer(2)), y),
+        div(exp(s), z)});
+    DenseMatrix X = DenseMatrix(3, 1, {x, y, z});
+    DenseMatrix J = DenseMatrix(3, 3);
+    jacobian(A, X, J);
+
+    LambdaRealDoubleBytecode v, v1;
+    v.init({x, y, z}, J);
+    REQUIRE(v.get_num_outputs() == 9);
+
+    double in[] = {0.3, 1.7, 2.5}, out[9];
+    v.call(out, in);
+    std::size_t n_code = 0;
+    for (unsigned i = 0; i < 3; i++) {
+        for (unsigned j = 0; j < 3; j++) {
+            v1.init({x, y, z}, *J.get(i, j));
+            n_code += v1.get_code().size();
+            double d = v1.call({in[0], in[1], in[2]});
+            REQUIRE(::fabs(out[3*i + j] - d) < 1e-12 * std::max(1.0, ::fabs(d)));
+        }
+    }
+    // Subexpressions like sin(x*y + z) and cos(x*y + z) are shared
+    REQUIRE(v.get_code().size() < n_code);
+
+    // Batch evaluation of several outputs
+    v.init({x, y, z}, {mul(s, x), add(x, z)});
+    std::vector<double> xs = {0.1, 0.2}, ys = {1.0, 2.0}, zs = {3.0, 4.0};
+    std::vector<double> o1(2), o2(2);
+    const double *inputs[] = {xs.data(), ys.data(), zs.data()};
+    double *outs[] = {o1.data(), o2.data()};
+    v.call_batch(inputs, outs, 2);
+    REQUIRE(::fabs(o1[1] - 0.2 * std::sin(0.2 * 2.0 + 4.0)) < 1e-12);
+    REQUIRE(::fabs(o2[0] - 3.1) < 1e-12);
+}
+
+TEST_CASE("Evaluate gradient using reverse mode", "[lambda_bytecode]")
+{
+    RCP<const Basic> x, y, z, s, e;
+    x = symbol("x");
+    y = symbol("y");
+    z = symbol("z");
+    s = sin(add(mul(x, y), z));
+    e = add(add(mul(s, pow(x, integer(3))), div(exp(s), z)),
+        add(pow(y, x), atan2(y, sqrt(z))));
+    e = add(e, add(mul(z, log(x)), pow(add(x, y), integer(-2))));
+
+    DenseMatrix A = DenseMatrix(1, 1, {e});
+    DenseMatrix X = DenseMatrix(3, 1, {x, y, z});
+    DenseMatrix J = DenseMatrix(1, 3);
+    jacobian(A, X, J);
+    LambdaRealDoubleBytecode v;
+    v.init({x, y, z}, J);
+
+    SymEngine::LambdaRealDoubleGradient g;
+    g.init({x, y, z}, *e);
+    double in[] = {0.3, 1.7, 2.5}, out[3], grad[3];
+    v.call(out, in);
+    double value = g.call_gradient(in, grad);
+    REQUIRE(::fabs(value - g.call({in[0], in[1], in[2]})) < 1e-12);
+    for (unsigned i = 0; i < 3; i++) {
+        REQUIRE(::fabs(grad[i] - out[i]) < 1e-10 * std::max(1.0, ::fabs(out[i])));
+    }
+
+    // Symbols the expression does not depend on get zero, abs() its sign
+    g.init({x, y, z}, {mul(x, x), SymEngine::abs(sub(x, y))});
+    g.call_gradient(in, grad);
+    REQUIRE(::fabs(grad[0] - 0.6) < 1e-15);
+    REQUIRE(grad[1] == 0);
+    REQUIRE(grad[2] == 0);
+    g.call_gradient(in, grad, 1);
+    REQUIRE(grad[0] == -1);
+    REQUIRE(grad[1] == 1);
+    REQUIRE(grad[2] == 0);
+
+    // The symbolic derivative of gamma() can not be compiled, compare with
+    // central differences
+    g.init({x, y, z}, *mul(gamma(z), x));
+    g.call_gradient(in, grad);
+    const double h = 1e-6;
+    double d = (std::tgamma(in[2] + h) - std::tgamma(in[2] - h)) / (2 * h);
+    REQUIRE(::fabs(grad[2] - in[0] * d) < 1e-7);
+    in[2] = -1.5;
+    g.call_gradient(in, grad);
+    d = (std::tgamma(in[2] + h) - std::tgamma(in[2] - h)) / (2 * h);
+    REQUIRE(::fabs(grad[2] - in[0] * d) < 1e-7);
+}
+
+TEST_CASE("Evaluate to double using native code", "[lambda_jit]")
+{
+    RCP<const Basic> x, y, s, r;
+    x = symbol("x");
+    y = symbol("y");
+    s = sin(add(x, y));
+    r = add(div(pow(s, integer(2)), add(y, integer(3))), mul(exp(x), s));
+
+    // The results are the same whether a C compiler is available or not
+    LambdaRealDoubleJIT v;
+    v.init({x, y}, {r, mul(s, x)});
+    LambdaRealDoubleBytecode v2;
+    v2.init({x, y}, {r, mul(s, x)});
+    double in[] = {0.7, -1.2}, out[2], out2[2];
+    v.call(out, in);
+    v2.call(out2, in);
+    REQUIRE(::fabs(out[0] - out2[0]) < 1e-12);
+    REQUIRE(::fabs(out[1] - out2[1]) < 1e-12);
+    REQUIRE(::fabs(v.call({0.7, -1.2}) - out2[0]) < 1e-12);
+
+    // Infinite values compile as well
+    bool native = v.is_native();
+    double inf = std::numeric_limits<double>::infinity();
+    v.init({x}, *add(x, real_double(inf)));
+    REQUIRE(v.is_native() == native);
+    REQUIRE(v.call({0.7}) == inf);
+
+    // A compiler that does not exist falls back to the bytecode
+    v.set_compiler("symengine-no-such-compiler");
+    v.init({x, y}, *r);
+    REQUIRE(not v.is_native());
+    REQUIRE(::fabs(v.call({0.7, -1.2}) - out2[0]) < 1e-12);
+
+    // Undefined symbols raise an exception
+    CHECK_THROWS_AS(v.init({x}, *r), std::runtime_error);
+}
@@ -37,3 +37,34 @@ TEST_CASE("Arithmetic of Expression", "[Expression]")
         << "ns" << std::endl;
     std::cout << res << std::endl;
 }
+
+TEST_CASE("Compound assignment of Expression", "[Expression]")
+{
+    Expression x = symbol("x"), y = symbol("y");
+    Expression s, p = 1;
+    for (int i = 0; i < 10; i++) {
+        s += x;
+        s -= y;
+        p *= x;
+    }
+    REQUIRE(s == 10 * x - 10 * y);
+    REQUIRE(p == pow_ex(x, 10));
+
+    // Operands shared with other expressions keep their value
+    Expression t = s;
+    t += y;
+    REQUIRE(s == 10 * x - 10 * y);
+    REQUIRE(t == 10 * x - 9 * y);
+    Expression q = p;
+    q *= x;
+    REQUIRE(p == pow_ex(x, 10));
+    REQUIRE(q == pow_ex(x, 11));
+
+    // Self assignment
+    t += t;
+    REQUIRE(t == 20 * x - 18 * y);
+    t -= 20 * x;
+    REQUIRE(t == -18 * y);
+    q *= q;
+    REQUIRE(q == pow_ex(x, 22));
+}
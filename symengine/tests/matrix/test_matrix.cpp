@@ -1,5 +1,6 @@
 #include "catch.hpp"
 #include <chrono>
+#include <cmath>
 
 #include <symengine/matrix.h>
 #include <symengine/integer.h>
@@ -7,6 +8,9 @@
 #include <symengine/add.h>
 #include <symengine/mul.h>
 #include <symengine/pow.h>
+#include <symengine/rational.h>
+#include <symengine/real_double.h>
+#include <symengine/numeric_matrix.h>
 
 using SymEngine::print_stack_on_segfault;
 using SymEngine::RCP;
@@ -23,6 +27,11 @@ using SymEngine::sub;
 using SymEngine::eye;
 using SymEngine::diag;
 using SymEngine::vec_basic;
+using SymEngine::real_double;
+using SymEngine::RealDouble;
+using SymEngine::IntegerDenseMatrix;
+using SymEngine::RationalDenseMatrix;
+using SymEngine::CSRSymbolicLU;
 
 TEST_CASE("test_get_set(): matrices", "[matrices]")
 {
@@ -48,6 +57,10 @@ TEST_CASE("test_get_set(): matrices", "[matrices]")
     REQUIRE(eq(*B.get(0, 0), *integer(1)));
     REQUIRE(eq(*B.get(1, 2), *integer(3)));
     REQUIRE(eq(*B.get(2, 1), *integer(5)));
+    // Entries of the next row are not read
+    REQUIRE(eq(*B.get(1, 0), *integer(0)));
+    REQUIRE(eq(*CSRMatrix(2, 2, {0, 1, 2}, {0, 1}, {integer(1), integer(2)})
+        .get(0, 1), *integer(0)));
 
     B.set(2, 1, integer(6));
     REQUIRE(B == CSRMatrix(3, 3, {0, 2, 3, 6}, {0, 2, 2, 0, 1, 2},
@@ -202,6 +215,57 @@ TEST_CASE("test_dense_dense_multiplication(): matrices", "[matrices]")
             mul(symbol("r"), symbol("z"))),
         add(add(mul(symbol("u"), symbol("x")), mul(symbol("v"), symbol("y"))),
             mul(symbol("w"), symbol("z")))}));
+
+    // Zeros and more columns than are summed at once
+    RCP<const Basic> x = symbol("x");
+    A = DenseMatrix(3, 3, {integer(0), x, integer(2),
+                           integer(0), integer(0), integer(0),
+                           x, integer(0), integer(-1)});
+    vec_basic b;
+    for (unsigned i = 0; i < 3*70; i++) {
+        if (i % 4 == 0)
+            b.push_back(integer(0));
+        else
+            b.push_back(add(x, integer(i)));
+    }
+    B = DenseMatrix(3, 70, b);
+    C = DenseMatrix(3, 70);
+    mul_dense_dense(A, B, C);
+
+    for (unsigned j = 0; j < 70; j++) {
+        RCP<const Basic> e0 = integer(0), e2 = integer(0);
+        for (unsigned k = 0; k < 3; k++) {
+            e0 = add(e0, mul(A.get(0, k), B.get(k, j)));
+            e2 = add(e2, mul(A.get(2, k), B.get(k, j)));
+        }
+        REQUIRE(eq(*C.get(0, j), *e0));
+        REQUIRE(eq(*C.get(1, j), *integer(0)));
+        REQUIRE(eq(*C.get(2, j), *e2));
+    }
+
+    // Enough products (20^3) to split the rows over the threads where
+    // SYMENGINE_PARALLEL is defined (OpenMP with thread safe RCPs)
+    vec_basic u, v;
+    for (unsigned i = 0; i < 20*20; i++) {
+        u.push_back(add(x, integer(i % 7)));
+        if (i % 5 == 0)
+            v.push_back(integer(0));
+        else
+            v.push_back(mul(x, integer(i % 11 + 1)));
+    }
+    A = DenseMatrix(20, 20, u);
+    B = DenseMatrix(20, 20, v);
+    C = DenseMatrix(20, 20);
+    mul_dense_dense(A, B, C);
+
+    for (unsigned i = 0; i < 20; i++) {
+        for (unsigned j = 0; j < 20; j++) {
+            RCP<const Basic> e = integer(0);
+            for (unsigned k = 0; k < 20; k++)
+                e = add(e, mul(A.get(i, k), B.get(k, j)));
+            REQUIRE(eq(*C.get(i, j), *e));
+        }
+    }
 }
 
 TEST_CASE("test_mul_dense_scalar(): matrices", "[matrices]")
@@ -1200,6 +1264,149 @@ TEST_CASE("test_inverse(): matrices", "[matrices]")
     REQUIRE(C == I3);
 }
 
+TEST_CASE("test_numeric_dense(): matrices", "[matrices]")
+{
+    RCP<const Basic> x = symbol("x");
+    DenseMatrix I3 = DenseMatrix(3, 3, {integer(1), integer(0), integer(0),
+                                        integer(0), integer(1), integer(0),
+                                        integer(0), integer(0), integer(1)});
+
+    // A zero leading entry needs a row exchange
+    DenseMatrix A = DenseMatrix(3, 3, {integer(0), integer(2), integer(-1),
+                                       integer(3), integer(1), integer(4),
+                                       integer(-2), integer(5), integer(7)});
+    REQUIRE(eq(*A.det(), *integer(-75)));
+    REQUIRE(A.rank() == 3);
+
+    DenseMatrix b = DenseMatrix(3, 1, {integer(1), integer(0), integer(2)});
+    DenseMatrix X = DenseMatrix(3, 1);
+    DenseMatrix C = DenseMatrix(3, 1);
+    LU_solve(A, b, X);
+    mul_dense_dense(A, X, C);
+    REQUIRE(C == b);
+    REQUIRE(eq(*X.get(0, 0), *div(integer(-1), integer(15))));
+
+    DenseMatrix B = DenseMatrix(3, 3);
+    DenseMatrix AB = DenseMatrix(3, 3);
+    inverse_LU(A, B);
+    mul_dense_dense(A, B, AB);
+    REQUIRE(AB == I3);
+
+    A = DenseMatrix(3, 3, {div(integer(1), integer(2)), integer(3),
+                           div(integer(-2), integer(3)),
+                           integer(1), div(integer(1), integer(5)), integer(0),
+                           div(integer(3), integer(4)), integer(2),
+                           div(integer(7), integer(6))});
+    REQUIRE(eq(*A.det(), *det_bareis(A)));
+    REQUIRE(A.rank() == 3);
+
+    b = DenseMatrix(3, 1, {div(integer(1), integer(3)), integer(-1),
+                           integer(2)});
+    fraction_free_LU_solve(A, b, X);
+    mul_dense_dense(A, X, C);
+    REQUIRE(C == b);
+    fraction_free_gauss_jordan_solve(A, b, X);
+    mul_dense_dense(A, X, C);
+    REQUIRE(C == b);
+
+    inverse_fraction_free_LU(A, B);
+    mul_dense_dense(A, B, AB);
+    REQUIRE(AB == I3);
+    inverse_gauss_jordan(A, B);
+    mul_dense_dense(A, B, AB);
+    REQUIRE(AB == I3);
+
+    A = DenseMatrix(4, 4, {integer(1), integer(2), integer(3), integer(4),
+                           integer(5), integer(6), integer(7), integer(8),
+                           integer(9), integer(10), integer(11), integer(12),
+                           integer(13), integer(14), integer(15), integer(16)});
+    REQUIRE(eq(*A.det(), *integer(0)));
+    REQUIRE(A.rank() == 2);
+
+    A = DenseMatrix(2, 3, {div(integer(1), integer(2)), integer(1), integer(0),
+                           integer(1), integer(2), integer(0)});
+    REQUIRE(A.rank() == 1);
+
+    A = DenseMatrix(2, 2, {real_double(2.0), integer(1),
+                           div(integer(1), integer(2)), real_double(4.0)});
+    RCP<const Basic> d = A.det();
+    REQUIRE(is_a<RealDouble>(*d));
+    REQUIRE(std::fabs(static_cast<const RealDouble &>(*d).i - 7.5) < 1e-12);
+    REQUIRE(A.rank() == 2);
+
+    b = DenseMatrix(2, 1, {real_double(1.0), real_double(2.0)});
+    X = DenseMatrix(2, 1);
+    LU_solve(A, b, X);
+    REQUIRE(is_a<RealDouble>(*X.get(0, 0)));
+    REQUIRE(std::fabs(static_cast<const RealDouble &>(*X.get(0, 0)).i
+        - 2.0 / 7.5) < 1e-12);
+    REQUIRE(std::fabs(static_cast<const RealDouble &>(*X.get(1, 0)).i
+        - 3.5 / 7.5) < 1e-12);
+
+    A = DenseMatrix(2, 2, {real_double(1.0), real_double(2.0),
+                           real_double(2.0), real_double(4.0)});
+    REQUIRE(A.rank() == 1);
+
+    // Symbolic entries are left to the symbolic algorithms
+    A = DenseMatrix(2, 2, {x, integer(1), integer(2), integer(3)});
+    REQUIRE(eq(*A.det(), *sub(mul(integer(3), x), integer(2))));
+    CHECK_THROWS_AS(A.rank(), std::runtime_error);
+
+    // The kernels on the numeric matrices
+    IntegerDenseMatrix M(2, 2);
+    M(0, 0) = 4; M(0, 1) = 6;
+    M(1, 0) = 2; M(1, 1) = 3;
+    REQUIRE(det_numeric(M) == 0);
+    REQUIRE(rank_numeric(M) == 1);
+    RationalDenseMatrix Y;
+    REQUIRE(not solve_numeric(M, M, Y));
+
+    M(1, 1) = 5;
+    REQUIRE(det_numeric(M) == 8);
+    IntegerDenseMatrix N(2, 1);
+    N(0, 0) = 1; N(1, 0) = 1;
+    REQUIRE(solve_numeric(M, N, Y));
+    REQUIRE(Y(0, 0) == mpq_class(-1, 8));
+    REQUIRE(Y(1, 0) == mpq_class(1, 4));
+}
+
+TEST_CASE("test_det_modular(): matrices", "[matrices]")
+{
+    IntegerDenseMatrix M(3, 3);
+    M.m_ = {2, 0, 1, 1, 3, 2, 1, 1, 2};
+    REQUIRE(det_modular(M) == 6);
+    REQUIRE(det_fraction_free(M) == 6);
+
+    M.m_ = {0, 2, -1, 3, 1, 4, -2, 5, 7};
+    REQUIRE(det_modular(M) == -75);
+
+    M.m_ = {1, 2, 3, 0, 0, 0, 4, 5, 6};
+    REQUIRE(det_modular(M) == 0);
+    M.m_ = {1, 2, 3, 2, 4, 6, 4, 5, 6};
+    REQUIRE(det_modular(M) == 0);
+
+    // Large entries need many primes, and the matrices from 24 rows on go
+    // through det_modular()
+    gmp_randclass r(gmp_randinit_default);
+    r.seed(7);
+    vec_basic a;
+    M = IntegerDenseMatrix(25, 25);
+    for (auto &e: M.m_) {
+        e = r.get_z_bits(80) - (mpz_class(1) << 79);
+        a.push_back(integer(e));
+    }
+    mpz_class d = det_fraction_free(M);
+    REQUIRE(det_modular(M) == d);
+    DenseMatrix A = DenseMatrix(25, 25, a);
+    REQUIRE(eq(*A.det(), *integer(d)));
+    REQUIRE(eq(*det_bareis(A), *integer(d)));
+
+    // A dependent row
+    for (unsigned j = 0; j < 25; j++)
+        M(24, j) = M(0, j) - 3 * M(1, j);
+    REQUIRE(det_modular(M) == 0);
+}
+
 TEST_CASE("test_csr_has_canonical_format(): matrices", "[matrices]")
 {
     std::vector<unsigned> p = {0, 2, 3, 6};
@@ -1330,6 +1537,157 @@ TEST_CASE("test_csr_binop_csr_canonical(): matrices", "[matrices]")
             integer(4), integer(5), integer(6)}));
 }
 
+TEST_CASE("test_csr_LU(): matrices", "[matrices]")
+{
+    CSRMatrix A = CSRMatrix(3, 3, {0, 2, 4, 6}, {0, 1, 0, 1, 1, 2},
+        {integer(2), integer(1), integer(4), integer(5), integer(3), integer(7)});
+    CSRMatrix L = CSRMatrix(3, 3), U = CSRMatrix(3, 3);
+
+    A.LU(L, U);
+    REQUIRE(L == CSRMatrix(3, 3, {0, 1, 3, 5}, {0, 0, 1, 1, 2},
+        {integer(1), integer(2), integer(1), integer(1), integer(1)}));
+    REQUIRE(U == CSRMatrix(3, 3, {0, 2, 3, 4}, {0, 1, 1, 2},
+        {integer(2), integer(1), integer(3), integer(7)}));
+
+    A = CSRMatrix(2, 2, {0, 1, 2}, {1, 0}, {integer(1), integer(1)});
+    CHECK_THROWS_AS(A.LU(L, U), std::runtime_error);
+}
+
+// Arrow matrix: a full first row and column, and a diagonal
+static CSRMatrix csr_arrow(unsigned n, unsigned offset)
+{
+    std::vector<unsigned> i, j;
+    vec_basic x;
+    for (unsigned k = 0; k < n; k++) {
+        i.push_back(k);
+        j.push_back(k);
+        x.push_back(integer(n + k + offset));
+        if (k > 0) {
+            i.push_back(0);
+            j.push_back(k);
+            x.push_back(integer(1));
+            i.push_back(k);
+            j.push_back(0);
+            x.push_back(integer(k + offset));
+        }
+    }
+    return CSRMatrix::from_coo(n, n, i, j, x);
+}
+
+static DenseMatrix csr_dense(const CSRMatrix &A)
+{
+    DenseMatrix D = DenseMatrix(A.nrows(), A.ncols());
+    for (unsigned i = 0; i < A.nrows(); i++)
+        for (unsigned j = 0; j < A.ncols(); j++)
+            D.set(i, j, A.get(i, j));
+    return D;
+}
+
+TEST_CASE("test_csr_symbolic_LU(): matrices", "[matrices]")
+{
+    const unsigned n = 12;
+    CSRMatrix A = csr_arrow(n, 0);
+
+    // Eliminating the first row and column after the others gives no fill in
+    CSRSymbolicLU S = CSRSymbolicLU(A);
+    REQUIRE(S.iperm_[0] >= n - 2);
+    REQUIRE(S.lp_[n] == n - 1);
+    REQUIRE(S.up_[n] == 2*n - 1);
+
+    CSRSymbolicLU N = CSRSymbolicLU(A, false);
+    REQUIRE(N.lp_[n] == n*(n - 1)/2);
+
+    CSRMatrix L = CSRMatrix(n, n), U = CSRMatrix(n, n);
+    DenseMatrix LU = DenseMatrix(n, n), PAP = DenseMatrix(n, n);
+    csr_LU(S, A, L, U);
+    mul_dense_dense(csr_dense(L), csr_dense(U), LU);
+    for (unsigned i = 0; i < n; i++)
+        for (unsigned j = 0; j < n; j++)
+            PAP.set(i, j, A.get(S.perm_[i], S.perm_[j]));
+    REQUIRE(LU == PAP);
+
+    // The analysis is reused for every matrix with the same pattern
+    DenseMatrix b = DenseMatrix(n, 1), x = DenseMatrix(n, 1),
+        y = DenseMatrix(n, 1);
+    for (unsigned i = 0; i < n; i++)
+        b.set(i, 0, integer(i + 1));
+    for (unsigned offset = 0; offset < 3; offset++) {
+        CSRMatrix B = csr_arrow(n, offset);
+        csr_LU_solve(S, B, b, x);
+        LU_solve(csr_dense(B), b, y);
+        REQUIRE(x == y);
+        REQUIRE(eq(*csr_det(S, B), *csr_dense(B).det()));
+    }
+
+    CSRMatrix C = CSRMatrix(n, n, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12},
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}, vec_basic(n, integer(1)));
+    CHECK_THROWS_AS(csr_LU_solve(S, C, b, x), std::runtime_error);
+}
+
+TEST_CASE("test_csr_det(): matrices", "[matrices]")
+{
+    CSRMatrix A = csr_arrow(10, 1);
+    REQUIRE(eq(*A.det(), *csr_dense(A).det()));
+
+    // Zero pivots are left to DenseMatrix
+    A = CSRMatrix(2, 2, {0, 1, 2}, {1, 0}, {integer(1), integer(1)});
+    REQUIRE(eq(*A.det(), *integer(-1)));
+    REQUIRE(eq(*CSRMatrix(3, 3).det(), *integer(0)));
+
+    A = CSRMatrix(2, 2, {0, 2, 3}, {0, 1, 1},
+        {real_double(2.0), real_double(3.0), real_double(0.5)});
+    REQUIRE(is_a<RealDouble>(*A.det()));
+    REQUIRE(std::abs(static_cast<const RealDouble &>(*A.det()).i - 1.0) < 1e-12);
+
+    A = CSRMatrix(2, 2, {0, 1, 3}, {0, 0, 1},
+        {symbol("a"), integer(1), symbol("b")});
+    REQUIRE(eq(*A.det(), *mul(symbol("a"), symbol("b"))));
+}
+
+TEST_CASE("test_csr_LU_solve(): matrices", "[matrices]")
+{
+    CSRMatrix A = CSRMatrix(3, 3, {0, 2, 4, 6}, {0, 1, 0, 1, 1, 2},
+        {integer(2), integer(1), integer(4), integer(5), integer(3), integer(7)});
+    DenseMatrix b = DenseMatrix(3, 1, {integer(3), integer(9), integer(10)});
+    DenseMatrix x = DenseMatrix(3, 1);
+
+    A.LU_solve(b, x);
+    REQUIRE(x == DenseMatrix(3, 1, {integer(1), integer(1), integer(1)}));
+
+    b = DenseMatrix(3, 1, {integer(1), integer(0), integer(0)});
+    A.LU_solve(b, x);
+    REQUIRE(x == DenseMatrix(3, 1, {div(integer(5), integer(6)),
+        div(integer(-2), integer(3)), div(integer(2), integer(7))}));
+
+    A = CSRMatrix(2, 2, {0, 1, 2}, {0, 1}, {symbol("a"), symbol("b")});
+    b = DenseMatrix(2, 1, {integer(1), symbol("b")});
+    x = DenseMatrix(2, 1);
+    A.LU_solve(b, x);
+    REQUIRE(x == DenseMatrix(2, 1, {div(integer(1), symbol("a")), integer(1)}));
+
+    // A zero pivot falls back to the pivoting dense solver
+    A = CSRMatrix(2, 2, {0, 1, 2}, {1, 0}, {integer(2), integer(4)});
+    b = DenseMatrix(2, 1, {integer(6), integer(8)});
+    A.LU_solve(b, x);
+    REQUIRE(x == DenseMatrix(2, 1, {integer(2), integer(3)}));
+}
+
+TEST_CASE("test_csr_inv(): matrices", "[matrices]")
+{
+    CSRMatrix A = csr_arrow(6, 2);
+    DenseMatrix B = DenseMatrix(6, 6), C = DenseMatrix(6, 6);
+
+    A.inv(B);
+    csr_dense(A).inv(C);
+    REQUIRE(B == C);
+
+    CSRMatrix D = CSRMatrix(2, 2, {0, 1, 2}, {0, 1}, {integer(2), integer(4)});
+    CSRMatrix E = CSRMatrix(2, 2);
+    D.inv(E);
+    REQUIRE(E == CSRMatrix(2, 2, {0, 1, 2}, {0, 1},
+        {div(integer(1), integer(2)), div(integer(1), integer(4))}));
+}
+
 TEST_CASE("test_eye(): matrices", "[matrices]")
 {
     DenseMatrix A;
@@ -1429,3 +1787,21 @@ TEST_CASE("Test Jacobian", "[matrices]")
             z, integer(1), x,
             integer(1), integer(1), integer(0)}));
 }
+
+TEST_CASE("Test Hessian", "[matrices]")
+{
+    RCP<const Basic> x = symbol("x");
+    RCP<const Basic> y = symbol("y");
+    RCP<const Basic> z = symbol("z");
+    RCP<const Basic> f = add(mul(pow(x, integer(2)), y), mul(y, z));
+    DenseMatrix X = DenseMatrix(3, 1, {x, y, z});
+    DenseMatrix H = DenseMatrix(3, 3);
+    hessian(f, X, H);
+    REQUIRE(H == DenseMatrix(3, 3,
+            {mul(integer(2), y), mul(integer(2), x), integer(0),
+            mul(integer(2), x), integer(0), integer(1),
+            integer(0), integer(1), integer(0)}));
+
+    X = DenseMatrix(3, 1, {x, mul(x, y), z});
+    CHECK_THROWS_AS(hessian(f, X, H), std::runtime_error);
+}
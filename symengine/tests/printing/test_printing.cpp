@@ -1,5 +1,6 @@
 #include "catch.hpp"
 #include <chrono>
+#include <limits>
 
 #include <symengine/basic.h>
 #include <symengine/integer.h>
@@ -336,6 +337,42 @@ TEST_CASE("test custom printing", "[printing]")
     CHECK(printer.apply(p) == "cos(MySin(x))");
 }
 
+TEST_CASE("test C code printing", "[printing]")
+{
+    RCP<const Basic> p;
+    RCP<const Basic> x = symbol("x");
+    RCP<const Basic> y = symbol("y");
+
+    p = div(x, integer(2));
+    CHECK(SymEngine::ccode(*p) == "(0.5)*x");
+    p = pow(add(x, y), integer(3));
+    CHECK(SymEngine::ccode(*p) == "pow(x + y, 3.0)");
+    p = div(SymEngine::sqrt(x), mul(y, SymEngine::exp(x)));
+    CHECK(SymEngine::ccode(*p) == "sqrt(x)*exp(-x)/y");
+    p = add(SymEngine::cot(x), SymEngine::abs(y));
+    CHECK(SymEngine::ccode(*p) == "(1.0/tan(x)) + fabs(y)");
+    p = mul(SymEngine::pi, x);
+    CHECK(SymEngine::ccode(*p) == "x*3.1415926535897931");
+    // Values without a C literal
+    double inf = std::numeric_limits<double>::infinity();
+    CHECK(SymEngine::ccode(*real_double(inf)) == "INFINITY");
+    CHECK(SymEngine::ccode(*real_double(-inf)) == "-INFINITY");
+    CHECK(SymEngine::ccode(*real_double(
+        std::numeric_limits<double>::quiet_NaN())) == "NAN");
+    CHECK(SymEngine::ccode(*pow(integer(10), integer(400))) == "INFINITY");
+    CHECK_THROWS_AS(SymEngine::ccode(*mul(I, x)), std::runtime_error);
+    CHECK_THROWS_AS(SymEngine::ccode(*function_symbol("f", x)), std::runtime_error);
+
+    std::string f = SymEngine::ccode_function("f", {x, y},
+        {sin(add(x, y)), mul(x, sin(add(x, y)))});
+    CHECK(f == "#include <math.h>\n\n"
+        "void f(double *out, const double *in)\n{\n"
+        "    const double t0 = sin(in[0] + in[1]);\n"
+        "    out[0] = t0;\n"
+        "    out[1] = in[0]*t0;\n"
+        "}\n");
+}
+
 TEST_CASE("Ascii Art", "[basic]")
 {
     std::cout << SymEngine::ascii_art() << std::endl;
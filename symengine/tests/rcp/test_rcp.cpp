@@ -1,4 +1,7 @@
 #include "catch.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #include <symengine/symengine_rcp.h>
 
@@ -108,3 +111,58 @@ TEST_CASE("Test rcp_from_this const 2", "[rcp]")
     f2_hybrid(*m2);
     REQUIRE(m2->use_count() == 1);
 }
+
+#if defined(WITH_SYMENGINE_RCP) and defined(WITH_SYMENGINE_THREAD_SAFE)
+
+class Counted : public EnableRCPFromThis<Counted> {
+public:
+    static std::atomic<int> alive;
+    Counted() { alive++; }
+    ~Counted() { alive--; }
+};
+
+std::atomic<int> Counted::alive(0);
+
+TEST_CASE("Test RCP shared between threads", "[rcp]")
+{
+    // Copies made and released by another thread
+    RCP<Counted> m = make_rcp<Counted>();
+    unsigned int count = 0;
+    std::thread t1([&m, &count]() {
+        std::vector<RCP<Counted>> v(100, m);
+        count = m->use_count();
+    });
+    t1.join();
+    REQUIRE(count == 101);
+    REQUIRE(m->use_count() == 1);
+    m.reset();
+    REQUIRE(Counted::alive == 0);
+
+    // Instance created by a thread that exits before it is released
+    std::thread t2([&m]() {
+        m = make_rcp<Counted>();
+        RCP<Counted> m2 = m;
+    });
+    t2.join();
+    REQUIRE(Counted::alive == 1);
+    REQUIRE(m->use_count() == 1);
+    RCP<Counted> m2 = m;
+    m.reset();
+    m2.reset();
+    REQUIRE(Counted::alive == 0);
+
+    // The last reference is released by another thread while the creating
+    // thread is alive. The instance is freed at the latest when the creating
+    // thread creates another instance.
+    m = make_rcp<Counted>();
+    std::thread t3([](RCP<Counted> r) {
+        RCP<Counted> r2 = r;
+    }, std::move(m));
+    t3.join();
+    m = make_rcp<Counted>();
+    REQUIRE(Counted::alive == 1);
+    m.reset();
+    REQUIRE(Counted::alive == 0);
+}
+
+#endif
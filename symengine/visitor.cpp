@@ -25,12 +25,12 @@ namespace SymEngine {
 void preorder_traversal(const Basic &b, Visitor &v)
 {
     b.accept(v);
-    for (const auto &p: b.get_args()) preorder_traversal(*p, v);
+    b.for_each_arg([&](const Basic &arg) { preorder_traversal(arg, v); });
 }
 
 void postorder_traversal(const Basic &b, Visitor &v)
 {
-    for (const auto &p: b.get_args()) postorder_traversal(*p, v);
+    b.for_each_arg([&](const Basic &arg) { postorder_traversal(arg, v); });
     b.accept(v);
 }
 
@@ -38,18 +38,17 @@ void preorder_traversal_stop(const Basic &b, StopVisitor &v)
 {
     b.accept(v);
     if (v.stop_) return;
-    for (const auto &p: b.get_args()) {
-        preorder_traversal_stop(*p, v);
-        if (v.stop_) return;
-    }
+    b.for_each_arg([&](const Basic &arg) {
+        if (not v.stop_) preorder_traversal_stop(arg, v);
+    });
 }
 
 void postorder_traversal_stop(const Basic &b, StopVisitor &v)
 {
-    for (const auto &p: b.get_args()) {
-        postorder_traversal_stop(*p, v);
-        if (v.stop_) return;
-    }
+    b.for_each_arg([&](const Basic &arg) {
+        if (not v.stop_) postorder_traversal_stop(arg, v);
+    });
+    if (v.stop_) return;
     b.accept(v);
 }
 
@@ -89,9 +88,7 @@ public:
     }
 
     void bvisit(const Basic &x) {
-        for (const auto &p: x.get_args()) {
-            p->accept(*this);
-        }
+        x.for_each_arg([this](const Basic &arg) { arg.accept(*this); });
     }
 
     set_basic apply(const Basic &b) {
@@ -6,6 +6,8 @@
 #ifndef SYMENGINE_VISITOR_H
 #define SYMENGINE_VISITOR_H
 
+#include <bitset>
+
 #include <symengine/basic.h>
 #include <symengine/add.h>
 #include <symengine/mul.h>
@@ -36,6 +38,11 @@ public:
 #   undef SYMENGINE_ENUM
 };
 
+/*! Visit `b` and its arguments recursively. The arguments are those of
+    Basic::for_each_arg(), so a term `2*x` of an Add is visited as `x` and
+    `2` and a factor `x**2` of a Mul as `x` and `2`, without building the Mul
+    and Pow of `get_args()`.
+*/
 void preorder_traversal(const Basic &b, Visitor &v);
 void postorder_traversal(const Basic &b, Visitor &v);
 
@@ -147,6 +154,59 @@ RCP<const Basic> coeff(const Basic &b, const RCP<const Basic> &x,
 
 set_basic free_symbols(const Basic &b);
 
+/*! Substitutes `subs_dict` into expressions, visiting every distinct subtree
+    only once: results are cached by node (hash and equality), so subtrees
+    shared in a DAG, or by several of the expressions passed to `apply()`,
+    are substituted once and reused. The result is the same as
+    `Basic::subs()`.
+
+    An instance is a compiled substitution: the dictionary is analyzed once,
+    and the cache is kept between calls to `apply()`, so it can be applied to
+    many expressions sharing subtrees with the same dictionary.
+
+    The dictionary is not copied, it must outlive the visitor:
+
+        map_basic_basic d = {{x, integer(2)}};
+        SubsVisitor s(d);
+        for (auto &e: exprs) e = s.apply(e);
+*/
+class SubsVisitor : public BaseVisitor<SubsVisitor> {
+protected:
+    const map_basic_basic &subs_dict_;
+    umap_basic_basic cache_;
+    RCP<const Basic> result_;
+    //! `key_types_[t]` is true if `subs_dict_` has a key of type `t`
+    std::bitset<TypeID_Count> key_types_;
+    bool number_keys_;
+public:
+    SubsVisitor(const map_basic_basic &subs_dict);
+    SubsVisitor(map_basic_basic &&subs_dict) = delete;
+
+    void bvisit(const Basic &x);
+    void bvisit(const Add &x);
+    void bvisit(const Mul &x);
+    void bvisit(const Pow &x);
+    void bvisit(const FunctionSymbol &x);
+    void bvisit(const Log &x);
+    void bvisit(const TrigFunction &x);
+    void bvisit(const HyperbolicFunction &x);
+
+    //! \return `x` with the dictionary substituted
+    RCP<const Basic> apply(const RCP<const Basic> &x);
+    //! Drops the cached results
+    inline void clear_cache() { cache_.clear(); }
+};
+
+/*! Common subexpression elimination. Subtrees (and subsets of the arguments
+    of Add and Mul) occurring more than once in `exprs` are replaced by new
+    symbols `x0, x1, ...` (skipping names already used in `exprs`).
+    `replacements` receives the `(symbol, subexpression)` pairs, in an order
+    where each subexpression only refers to the symbols defined before it,
+    and `reduced_exprs` receives `exprs` rewritten in terms of them.
+*/
+void cse(vec_pair &replacements, vec_basic &reduced_exprs,
+        const vec_basic &exprs);
+
 } // SymEngine
 
 #endif